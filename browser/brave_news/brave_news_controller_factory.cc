@@ -20,6 +20,12 @@
 
 namespace brave_news {
 
+namespace {
+
+constexpr char kFeedCacheDirName[] = "brave_news";
+
+}  // namespace
+
 // static
 BraveNewsControllerFactory* BraveNewsControllerFactory::GetInstance() {
   return base::Singleton<BraveNewsControllerFactory>::get();
@@ -72,9 +78,10 @@ KeyedService* BraveNewsControllerFactory::BuildServiceInstanceFor(
   auto* ads_service = brave_ads::AdsServiceFactory::GetForProfile(profile);
   auto* history_service = HistoryServiceFactory::GetForProfile(
       profile, ServiceAccessType::EXPLICIT_ACCESS);
-  return new BraveNewsController(profile->GetPrefs(), favicon_service,
-                                 ads_service, history_service,
-                                 profile->GetURLLoaderFactory());
+  return new BraveNewsController(
+      profile->GetPrefs(), favicon_service, ads_service, history_service,
+      profile->GetURLLoaderFactory(),
+      profile->GetPath().AppendASCII(kFeedCacheDirName));
 }
 
 content::BrowserContext* BraveNewsControllerFactory::GetBrowserContextToUse(
@@ -23,11 +23,13 @@
 #include "brave/components/constants/brave_paths.h"
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
+#include "brave/components/greaselion/browser/greaselion_service_impl.h"
 #include "chrome/browser/extensions/extension_browsertest.h"
 #include "chrome/test/base/ui_test_utils.h"
 #include "content/public/test/browser_test.h"
 #include "content/public/test/browser_test_utils.h"
-#include "extensions/common/file_util.h"
+#include "extensions/browser/extension_registry.h"
+#include "extensions/browser/extension_registry_observer.h"
 #include "net/dns/mock_host_resolver.h"
 #include "ui/base/ui_base_switches.h"
 
@@ -99,6 +101,39 @@ class GreaselionServiceWaiter : public GreaselionService::Observer {
       scoped_observer_{this};
 };
 
+// Counts extensions loaded and unloaded for a profile while it exists.
+class ExtensionLoadCounter : public extensions::ExtensionRegistryObserver {
+ public:
+  explicit ExtensionLoadCounter(content::BrowserContext* context) {
+    scoped_observer_.Observe(extensions::ExtensionRegistry::Get(context));
+  }
+  ExtensionLoadCounter(const ExtensionLoadCounter&) = delete;
+  ExtensionLoadCounter& operator=(const ExtensionLoadCounter&) = delete;
+  ~ExtensionLoadCounter() override = default;
+
+  int loaded() const { return loaded_; }
+  int unloaded() const { return unloaded_; }
+
+ private:
+  // extensions::ExtensionRegistryObserver:
+  void OnExtensionLoaded(content::BrowserContext* browser_context,
+                         const extensions::Extension* extension) override {
+    ++loaded_;
+  }
+  void OnExtensionUnloaded(
+      content::BrowserContext* browser_context,
+      const extensions::Extension* extension,
+      extensions::UnloadedExtensionReason reason) override {
+    ++unloaded_;
+  }
+
+  int loaded_ = 0;
+  int unloaded_ = 0;
+  base::ScopedObservation<extensions::ExtensionRegistry,
+                          extensions::ExtensionRegistryObserver>
+      scoped_observer_{this};
+};
+
 class GreaselionServiceTest : public BaseLocalDataFilesBrowserTest {
  public:
   GreaselionServiceTest(): https_server_(net::EmbeddedTestServer::TYPE_HTTPS) {
@@ -562,59 +597,72 @@ IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, CleanShutdown) {
   ui_test_utils::WaitForBrowserToClose(browser());
 }
 
-IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, FoldersAreRemovedOnUpdate) {
+IN_PROC_BROWSER_TEST_F(GreaselionServiceTest, CachedFoldersAreReusedOnUpdate) {
   ASSERT_TRUE(InstallMockExtension());
 
   auto io_runner = base::ThreadPool::CreateSequencedTaskRunner(
       {base::MayBlock(), base::TaskShutdownBehavior::BLOCK_SHUTDOWN});
 
-  auto count_folders_on_io_runner = [&io_runner]() {
+  // Maps every file under the converted extensions directory to its last
+  // modification time.
+  using FileTimes = base::flat_map<base::FilePath, base::Time>;
+  auto get_file_times_on_io_runner = [&io_runner]() {
     base::RunLoop run_loop;
-    size_t folder_count;
+    FileTimes file_times;
 
-    auto set_folder_count = [&folder_count, &run_loop](size_t count) {
-      folder_count = count;
+    auto set_file_times = [&file_times, &run_loop](FileTimes result) {
+      file_times = std::move(result);
       run_loop.Quit();
     };
 
-    auto count_folders = []() {
+    auto get_file_times = []() {
       base::FilePath install_dir =
           GreaselionServiceFactory::GetInstallDirectory();
 
       base::FilePath extensions_dir =
-          extensions::file_util::GetInstallTempDir(install_dir);
+          install_dir.AppendASCII(
+              greaselion::kGreaselionConvertedExtensionsDir);
 
-      base::FileEnumerator enumerator(extensions_dir, false,
-                                      base::FileEnumerator::DIRECTORIES);
-      size_t count = 0;
+      base::FileEnumerator enumerator(extensions_dir, true,
+                                      base::FileEnumerator::FILES);
+      FileTimes result;
       for (base::FilePath name = enumerator.Next(); !name.empty();
            name = enumerator.Next()) {
-        ++count;
+        result[name] = enumerator.GetInfo().GetLastModifiedTime();
       }
-      return count;
+      return result;
     };
 
     io_runner->PostTaskAndReplyWithResult(
-        FROM_HERE, base::BindOnce(count_folders),
-        base::BindLambdaForTesting(set_folder_count));
+        FROM_HERE, base::BindOnce(get_file_times),
+        base::BindLambdaForTesting(set_file_times));
 
     run_loop.Run();
-    return folder_count;
+    return file_times;
   };
 
-  size_t start_count = count_folders_on_io_runner();
-  EXPECT_GT(start_count, 0ul);
-
-  // Trigger an update to reinstall extension folders and wait for all
-  // extensions to finish loading.
   GreaselionService* greaselion_service =
       GreaselionServiceFactory::GetForBrowserContext(profile());
   ASSERT_TRUE(greaselion_service);
+
+  const FileTimes start_file_times = get_file_times_on_io_runner();
+  EXPECT_FALSE(start_file_times.empty());
+  const auto start_extension_ids =
+      greaselion_service->GetExtensionIdsForTesting();
+  EXPECT_FALSE(start_extension_ids.empty());
+
+  // Trigger an update with unchanged rules and wait for it to finish. The
+  // cached conversions should be reused as is: nothing is unloaded, reloaded
+  // or written again.
+  ExtensionLoadCounter load_counter(profile());
   greaselion_service->UpdateInstalledExtensions();
   GreaselionServiceWaiter(greaselion_service).Wait();
 
-  size_t after_update = count_folders_on_io_runner();
-  EXPECT_EQ(after_update, start_count);
+  EXPECT_EQ(0, load_counter.loaded());
+  EXPECT_EQ(0, load_counter.unloaded());
+  EXPECT_EQ(start_extension_ids,
+            greaselion_service->GetExtensionIdsForTesting());
+  EXPECT_EQ(start_file_times, get_file_times_on_io_runner());
 }
 
 #if !BUILDFLAG(IS_MAC)
@@ -6,13 +6,11 @@
 #include "brave/browser/net/brave_query_filter.h"
 
 #include <string>
-#include <vector>
 
 #include "base/containers/fixed_flat_map.h"
 #include "base/containers/fixed_flat_set.h"
 #include "base/strings/string_piece.h"
-#include "base/strings/string_split.h"
-#include "base/strings/string_util.h"
+#include "brave/components/url_sanitizer/browser/strip_query_parameters.h"
 #include "third_party/re2/src/re2/re2.h"
 #include "url/gurl.h"
 
@@ -71,60 +69,34 @@ static constexpr auto kScopedQueryStringTrackers =
         {"t", "twitter.com"},
     });
 
-// Remove tracking query parameters from a GURL, leaving all
-// other parts untouched.
-absl::optional<std::string> StripQueryParameter(const base::StringPiece& query,
-                                                const std::string& spec) {
-  // We are using custom query string parsing code here. See
-  // https://github.com/brave/brave-core/pull/13726#discussion_r897712350
-  // for more information on why this approach was selected.
-  //
-  // Split query string by ampersands, remove tracking parameters,
-  // then join the remaining query parameters, untouched, back into
-  // a single query string.
-  const std::vector<base::StringPiece> input_kv_strings =
-      SplitStringPiece(query, "&", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
-  std::vector<base::StringPiece> output_kv_strings;
-  int disallowed_count = 0;
-  for (const auto& kv_string : input_kv_strings) {
-    const std::vector<base::StringPiece> pieces = SplitStringPiece(
-        kv_string, "=", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-    const base::StringPiece& key = pieces.empty() ? "" : pieces[0];
-    if (pieces.size() >= 2 &&
-        (kSimpleQueryStringTrackers.count(key) == 1 ||
-         (kScopedQueryStringTrackers.count(key) == 1 &&
-          GURL(spec).DomainIs(kScopedQueryStringTrackers.at(key).data())) ||
-         (kConditionalQueryStringTrackers.count(key) == 1 &&
-          !re2::RE2::PartialMatch(
-              spec, kConditionalQueryStringTrackers.at(key).data())))) {
-      ++disallowed_count;
-    } else {
-      output_kv_strings.push_back(kv_string);
-    }
+bool IsTrackerQueryKey(base::StringPiece key, const GURL& url) {
+  if (kSimpleQueryStringTrackers.contains(key))
+    return true;
+  const auto scoped = kScopedQueryStringTrackers.find(key);
+  if (scoped != kScopedQueryStringTrackers.end())
+    return url.DomainIs(scoped->second);
+  const auto conditional = kConditionalQueryStringTrackers.find(key);
+  if (conditional != kConditionalQueryStringTrackers.end()) {
+    return !re2::RE2::PartialMatch(url.spec(), conditional->second.data());
   }
-  if (disallowed_count > 0) {
-    return base::JoinString(output_kv_strings, "&");
-  }
-  return absl::nullopt;
+  return false;
 }
 
 }  // namespace
 
 absl::optional<GURL> ApplyQueryFilter(const GURL& original_url) {
-  const auto& query = original_url.query_piece();
-  const std::string& spec = original_url.spec();
-  const auto clean_query_value = StripQueryParameter(query, spec);
+  const auto clean_query_value = brave::StripQueryParameters(
+      original_url.query_piece(), [&original_url](base::StringPiece key) {
+        return IsTrackerQueryKey(key, original_url);
+      });
   if (!clean_query_value.has_value())
     return absl::nullopt;
   const auto& clean_query = clean_query_value.value();
-  if (clean_query.length() < query.length()) {
-    GURL::Replacements replacements;
-    if (clean_query.empty()) {
-      replacements.ClearQuery();
-    } else {
-      replacements.SetQueryStr(clean_query);
-    }
-    return original_url.ReplaceComponents(replacements);
+  GURL::Replacements replacements;
+  if (clean_query.empty()) {
+    replacements.ClearQuery();
+  } else {
+    replacements.SetQueryStr(clean_query);
   }
-  return absl::nullopt;
+  return original_url.ReplaceComponents(replacements);
 }
@@ -8,7 +8,6 @@
 #include <algorithm>
 #include <utility>
 
-#include "base/containers/contains.h"
 #include "base/feature_list.h"
 #include "brave/browser/net/brave_ad_block_csp_network_delegate_helper.h"
 #include "brave/browser/net/brave_ad_block_tp_network_delegate_helper.h"
@@ -56,112 +55,128 @@ static bool IsInternalScheme(std::shared_ptr<brave::BraveRequestInfo> ctx) {
   return ctx->request_url.SchemeIs(content::kChromeUIScheme);
 }
 
-BraveRequestHandler::BraveRequestHandler() {
-  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
-  SetupCallbacks();
-}
-
-BraveRequestHandler::~BraveRequestHandler() = default;
+namespace {
 
-void BraveRequestHandler::SetupCallbacks() {
-  brave::OnBeforeURLRequestCallback callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_SiteHacksWork);
-  before_url_request_callbacks_.push_back(callback);
+using Stage = BraveRequestHandler::Stage;
 
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_AdBlockTPPreWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(brave::OnBeforeURLRequest_HttpsePreFileWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback =
-      base::BindRepeating(brave::OnBeforeURLRequest_CommonStaticRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
-
-  callback = base::BindRepeating(
-      decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork);
-  before_url_request_callbacks_.push_back(callback);
+// Adapts an OnBeforeStartTransaction helper to the common stage signature.
+template <int (*kWork)(net::HttpRequestHeaders* headers,
+                       const brave::ResponseCallback& next_callback,
+                       std::shared_ptr<brave::BraveRequestInfo> ctx)>
+int RunWithRequestHeaders(const brave::ResponseCallback& next_callback,
+                          std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  return kWork(ctx->headers, next_callback, ctx);
+}
 
-  callback = base::BindRepeating(brave_rewards::OnBeforeURLRequest);
-  before_url_request_callbacks_.push_back(callback);
+// Adapts an OnHeadersReceived helper to the common stage signature.
+template <int (*kWork)(
+    const net::HttpResponseHeaders* original_response_headers,
+    scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
+    GURL* allowed_unsafe_redirect_url,
+    const brave::ResponseCallback& next_callback,
+    std::shared_ptr<brave::BraveRequestInfo> ctx)>
+int RunWithResponseHeaders(const brave::ResponseCallback& next_callback,
+                           std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  return kWork(ctx->original_response_headers, ctx->override_response_headers,
+               ctx->allowed_unsafe_redirect_url, next_callback, ctx);
+}
 
 #if BUILDFLAG(ENABLE_IPFS)
-  if (base::FeatureList::IsEnabled(ipfs::features::kIpfsFeature)) {
-    callback = base::BindRepeating(ipfs::OnBeforeURLRequest_IPFSRedirectWork);
-    before_url_request_callbacks_.push_back(callback);
-  }
+bool IsIpfsEnabled() {
+  return base::FeatureList::IsEnabled(ipfs::features::kIpfsFeature);
+}
 #endif
 
-  brave::OnBeforeStartTransactionCallback start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_SiteHacksWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+bool IsReduceLanguageEnabled() {
+  return base::FeatureList::IsEnabled(
+      brave_shields::features::kBraveReduceLanguage);
+}
 
-  start_transaction_callback = base::BindRepeating(
-      brave::OnBeforeStartTransaction_GlobalPrivacyControlWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+bool IsAdblockCspRulesEnabled() {
+  return base::FeatureList::IsEnabled(
+      brave_shields::features::kBraveAdblockCspRules);
+}
 
-  start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_BraveServiceKey);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+// All network hooks, grouped by event type and in the order they run.
+constexpr Stage kStages[] = {
+    {brave::kOnBeforeRequest, &brave::OnBeforeURLRequest_SiteHacksWork},
+    {brave::kOnBeforeRequest, &brave::OnBeforeURLRequest_AdBlockTPPreWork},
+    {brave::kOnBeforeRequest, &brave::OnBeforeURLRequest_HttpsePreFileWork},
+    {brave::kOnBeforeRequest,
+     &brave::OnBeforeURLRequest_CommonStaticRedirectWork},
+    {brave::kOnBeforeRequest,
+     &decentralized_dns::OnBeforeURLRequest_DecentralizedDnsPreRedirectWork},
+    {brave::kOnBeforeRequest, &brave_rewards::OnBeforeURLRequest},
+#if BUILDFLAG(ENABLE_IPFS)
+    {brave::kOnBeforeRequest, &ipfs::OnBeforeURLRequest_IPFSRedirectWork,
+     &IsIpfsEnabled},
+#endif
 
+    {brave::kOnBeforeStartTransaction,
+     &RunWithRequestHeaders<brave::OnBeforeStartTransaction_SiteHacksWork>},
+    {brave::kOnBeforeStartTransaction,
+     &RunWithRequestHeaders<
+         brave::OnBeforeStartTransaction_GlobalPrivacyControlWork>},
+    {brave::kOnBeforeStartTransaction,
+     &RunWithRequestHeaders<brave::OnBeforeStartTransaction_BraveServiceKey>},
 #if BUILDFLAG(ENABLE_BRAVE_REFERRALS)
-  start_transaction_callback =
-      base::BindRepeating(brave::OnBeforeStartTransaction_ReferralsWork);
-  before_start_transaction_callbacks_.push_back(start_transaction_callback);
+    {brave::kOnBeforeStartTransaction,
+     &RunWithRequestHeaders<brave::OnBeforeStartTransaction_ReferralsWork>},
 #endif
-
-  if (base::FeatureList::IsEnabled(
-          brave_shields::features::kBraveReduceLanguage)) {
-    start_transaction_callback =
-        base::BindRepeating(brave::OnBeforeStartTransaction_ReduceLanguageWork);
-    before_start_transaction_callbacks_.push_back(start_transaction_callback);
-  }
+    {brave::kOnBeforeStartTransaction,
+     &RunWithRequestHeaders<
+         brave::OnBeforeStartTransaction_ReduceLanguageWork>,
+     &IsReduceLanguageEnabled},
 
 #if BUILDFLAG(ENABLE_BRAVE_WEBTORRENT)
-  brave::OnHeadersReceivedCallback headers_received_callback =
-      base::BindRepeating(webtorrent::OnHeadersReceived_TorrentRedirectWork);
-  headers_received_callbacks_.push_back(headers_received_callback);
+    {brave::kOnHeadersReceived,
+     &RunWithResponseHeaders<
+         webtorrent::OnHeadersReceived_TorrentRedirectWork>},
 #endif
+    {brave::kOnHeadersReceived,
+     &RunWithResponseHeaders<brave::OnHeadersReceived_AdBlockCspWork>,
+     &IsAdblockCspRulesEnabled},
+};
 
-  if (base::FeatureList::IsEnabled(
-          ::brave_shields::features::kBraveAdblockCspRules)) {
-    brave::OnHeadersReceivedCallback headers_received_callback2 =
-        base::BindRepeating(brave::OnHeadersReceived_AdBlockCspWork);
-    headers_received_callbacks_.push_back(headers_received_callback2);
+}  // namespace
+
+BraveRequestHandler::BraveRequestHandler() {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  for (const Stage& stage : kStages) {
+    if (!stage.is_enabled || stage.is_enabled())
+      stages_.push_back(stage);
   }
 }
 
-bool BraveRequestHandler::IsRequestIdentifierValid(
-    uint64_t request_identifier) {
-  return base::Contains(callbacks_, request_identifier);
+BraveRequestHandler::BraveRequestHandler(std::vector<Stage> stages)
+    : stages_(std::move(stages)) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 }
 
+BraveRequestHandler::~BraveRequestHandler() = default;
+
 int BraveRequestHandler::OnBeforeURLRequest(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     GURL* new_url) {
-  if (before_url_request_callbacks_.empty() || IsInternalScheme(ctx)) {
+  if (IsInternalScheme(ctx)) {
     return net::OK;
   }
   ctx->new_url = new_url;
   ctx->event_type = brave::kOnBeforeRequest;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartStages(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnBeforeStartTransaction(
     std::shared_ptr<brave::BraveRequestInfo> ctx,
     net::CompletionOnceCallback callback,
     net::HttpRequestHeaders* headers) {
-  if (before_start_transaction_callbacks_.empty() || IsInternalScheme(ctx)) {
+  if (IsInternalScheme(ctx)) {
     return net::OK;
   }
   ctx->event_type = brave::kOnBeforeStartTransaction;
   ctx->headers = headers;
-  callbacks_[ctx->request_identifier] = std::move(callback);
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartStages(ctx, std::move(callback));
 }
 
 int BraveRequestHandler::OnHeadersReceived(
@@ -176,129 +191,112 @@ int BraveRequestHandler::OnHeadersReceived(
         original_response_headers, override_response_headers);
   }
 
-  if (headers_received_callbacks_.empty() &&
-      !ctx->request_url.SchemeIs(content::kChromeUIScheme)) {
-    // Extension scheme not excluded since brave_webtorrent needs it.
-    return net::OK;
-  }
-
-  callbacks_[ctx->request_identifier] = std::move(callback);
+  // Extension scheme not excluded since brave_webtorrent needs it.
   ctx->event_type = brave::kOnHeadersReceived;
   ctx->original_response_headers = original_response_headers;
   ctx->override_response_headers = override_response_headers;
   ctx->allowed_unsafe_redirect_url = allowed_unsafe_redirect_url;
-
-  RunNextCallback(ctx);
-  return net::ERR_IO_PENDING;
+  return StartStages(ctx, std::move(callback));
 }
 
 void BraveRequestHandler::OnURLRequestDestroyed(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
-  if (base::Contains(callbacks_, ctx->request_identifier)) {
-    callbacks_.erase(ctx->request_identifier);
-  }
+  // Stages that are still in flight hold |ctx|; dropping the callback makes
+  // them stop at the next step instead of reporting to a dead request.
+  ctx->completion_callback.Reset();
 }
 
-void BraveRequestHandler::RunCallbackForRequestIdentifier(
-    uint64_t request_identifier,
-    int rv) {
-  std::map<uint64_t, net::CompletionOnceCallback>::iterator it =
-      callbacks_.find(request_identifier);
-  // We intentionally do the async call to maintain the proper flow
-  // of URLLoader callbacks.
-  content::GetUIThreadTaskRunner({})->PostTask(
-      FROM_HERE, base::BindOnce(std::move(it->second), rv));
+int BraveRequestHandler::StartStages(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    net::CompletionOnceCallback callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  ctx->next_url_request_index =
+      std::find_if(stages_.begin(), stages_.end(),
+                   [&ctx](const Stage& stage) {
+                     return stage.event_type == ctx->event_type;
+                   }) -
+      stages_.begin();
+  ctx->completion_callback = std::move(callback);
+
+  int rv = RunStages(ctx);
+  if (rv == net::ERR_IO_PENDING) {
+    return rv;
+  }
+
+  // Every stage finished synchronously, so hand the result straight back
+  // instead of posting it; callers handle these two results inline.
+  if (rv == net::OK || rv == net::ERR_BLOCKED_BY_CLIENT) {
+    ctx->completion_callback.Reset();
+    return rv;
+  }
+  RunCompletionCallback(ctx, rv);
+  return net::ERR_IO_PENDING;
 }
 
-// TODO(iefremov): Merge all callback containers into one and run only one loop
-// instead of many (issues/5574).
-void BraveRequestHandler::RunNextCallback(
+int BraveRequestHandler::RunStages(
     std::shared_ptr<brave::BraveRequestInfo> ctx) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
 
-  if (!base::Contains(callbacks_, ctx->request_identifier)) {
-    return;
-  }
-
   if (ctx->pending_error.has_value()) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                    ctx->pending_error.value());
-    return;
+    return ctx->pending_error.value();
   }
 
-  // Continue processing callbacks until we hit one that returns PENDING
-  int rv = net::OK;
-
-  if (ctx->event_type == brave::kOnBeforeRequest) {
-    while (before_url_request_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeURLRequestCallback callback =
-          before_url_request_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::BindRepeating(&BraveRequestHandler::RunNextCallback,
-                              weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
+  // Shared by all stages of this run; only an asynchronous stage keeps it.
+  brave::ResponseCallback next_callback;
+  while (ctx->next_url_request_index < stages_.size()) {
+    const Stage& stage = stages_[ctx->next_url_request_index];
+    if (stage.event_type != ctx->event_type) {
+      break;
     }
-  } else if (ctx->event_type == brave::kOnBeforeStartTransaction) {
-    while (before_start_transaction_callbacks_.size() !=
-           ctx->next_url_request_index) {
-      brave::OnBeforeStartTransactionCallback callback =
-          before_start_transaction_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::BindRepeating(&BraveRequestHandler::RunNextCallback,
-                              weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->headers, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
+    ctx->next_url_request_index++;
+
+    if (!next_callback) {
+      next_callback = base::BindRepeating(&BraveRequestHandler::RunNextCallback,
+                                          weak_factory_.GetWeakPtr(), ctx);
     }
-  } else if (ctx->event_type == brave::kOnHeadersReceived) {
-    while (headers_received_callbacks_.size() != ctx->next_url_request_index) {
-      brave::OnHeadersReceivedCallback callback =
-          headers_received_callbacks_[ctx->next_url_request_index++];
-      brave::ResponseCallback next_callback =
-          base::BindRepeating(&BraveRequestHandler::RunNextCallback,
-                              weak_factory_.GetWeakPtr(), ctx);
-      rv = callback.Run(ctx->original_response_headers,
-                        ctx->override_response_headers,
-                        ctx->allowed_unsafe_redirect_url, next_callback, ctx);
-      if (rv == net::ERR_IO_PENDING) {
-        return;
-      }
-      if (rv != net::OK) {
-        break;
-      }
+    int rv = stage.run(next_callback, ctx);
+    if (rv != net::OK) {
+      return rv;
     }
   }
 
-  if (rv != net::OK) {
-    RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
-    return;
-  }
-
   if (ctx->event_type == brave::kOnBeforeRequest) {
     if (!ctx->new_url_spec.empty() &&
-        (ctx->new_url_spec != ctx->request_url.spec()) &&
-        IsRequestIdentifierValid(ctx->request_identifier)) {
+        (ctx->new_url_spec != ctx->request_url.spec())) {
       *ctx->new_url = GURL(ctx->new_url_spec);
     }
     if (ctx->blocked_by == brave::kAdBlocked ||
         ctx->blocked_by == brave::kOtherBlocked) {
       if (!ctx->ShouldMockRequest()) {
-        RunCallbackForRequestIdentifier(ctx->request_identifier,
-                                        net::ERR_BLOCKED_BY_CLIENT);
-        return;
+        return net::ERR_BLOCKED_BY_CLIENT;
       }
     }
   }
-  RunCallbackForRequestIdentifier(ctx->request_identifier, rv);
+  return net::OK;
+}
+
+void BraveRequestHandler::RunNextCallback(
+    std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  // The request is gone, or its pipeline already reported a result.
+  if (!ctx->completion_callback) {
+    return;
+  }
+
+  int rv = RunStages(ctx);
+  if (rv != net::ERR_IO_PENDING) {
+    RunCompletionCallback(ctx, rv);
+  }
+}
+
+void BraveRequestHandler::RunCompletionCallback(
+    std::shared_ptr<brave::BraveRequestInfo> ctx,
+    int rv) {
+  DCHECK(ctx->completion_callback);
+  // We intentionally do the async call to maintain the proper flow
+  // of URLLoader callbacks.
+  content::GetUIThreadTaskRunner({})->PostTask(
+      FROM_HERE, base::BindOnce(std::move(ctx->completion_callback), rv));
 }
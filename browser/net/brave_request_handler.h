@@ -6,7 +6,6 @@
 #ifndef BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 #define BRAVE_BROWSER_NET_BRAVE_REQUEST_HANDLER_H_
 
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,13 +20,27 @@ class PrefChangeRegistrar;
 // API).
 class BraveRequestHandler {
  public:
+  // A single step of the pipeline, run for requests of |event_type|. Stages
+  // for one event type are contiguous and run in order until one of them
+  // returns ERR_IO_PENDING or an error.
+  struct Stage {
+    using RunFunction = int (*)(const brave::ResponseCallback& next_callback,
+                                std::shared_ptr<brave::BraveRequestInfo> ctx);
+    using IsEnabledFunction = bool (*)();
+
+    brave::BraveNetworkDelegateEventType event_type;
+    RunFunction run;
+    // Evaluated once on construction; null means always enabled.
+    IsEnabledFunction is_enabled = nullptr;
+  };
+
   BraveRequestHandler();
+  // For tests. Runs |stages| instead of the built-in stage table.
+  explicit BraveRequestHandler(std::vector<Stage> stages);
   BraveRequestHandler(const BraveRequestHandler&) = delete;
   BraveRequestHandler& operator=(const BraveRequestHandler&) = delete;
   ~BraveRequestHandler();
 
-  bool IsRequestIdentifierValid(uint64_t request_identifier);
-
   int OnBeforeURLRequest(std::shared_ptr<brave::BraveRequestInfo> ctx,
                          net::CompletionOnceCallback callback,
                          GURL* new_url);
@@ -43,18 +56,23 @@ class BraveRequestHandler {
       GURL* allowed_unsafe_redirect_url);
 
   void OnURLRequestDestroyed(std::shared_ptr<brave::BraveRequestInfo> ctx);
-  void RunCallbackForRequestIdentifier(uint64_t request_identifier, int rv);
 
  private:
-  void SetupCallbacks();
+  // Starts the stages for |ctx->event_type|. Returns the result directly if
+  // every stage completes synchronously, otherwise ERR_IO_PENDING and
+  // |callback| is run once the pipeline finishes.
+  int StartStages(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                  net::CompletionOnceCallback callback);
+  // Runs stages until one of them goes asynchronous (returns ERR_IO_PENDING)
+  // or all are done, in which case the pipeline result is returned.
+  int RunStages(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  // Resumes the pipeline after an asynchronous stage called |next_callback|.
   void RunNextCallback(std::shared_ptr<brave::BraveRequestInfo> ctx);
+  void RunCompletionCallback(std::shared_ptr<brave::BraveRequestInfo> ctx,
+                             int rv);
 
-  std::vector<brave::OnBeforeURLRequestCallback> before_url_request_callbacks_;
-  std::vector<brave::OnBeforeStartTransactionCallback>
-      before_start_transaction_callbacks_;
-  std::vector<brave::OnHeadersReceivedCallback> headers_received_callbacks_;
-
-  std::map<uint64_t, net::CompletionOnceCallback> callbacks_;
+  // Enabled entries of the stage table, in table order.
+  std::vector<Stage> stages_;
 
   base::WeakPtrFactory<BraveRequestHandler> weak_factory_{this};
 };
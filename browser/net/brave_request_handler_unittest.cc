@@ -0,0 +1,147 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/brave_request_handler.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "brave/browser/net/url_context.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_request_headers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace {
+
+int g_sync_stage_runs = 0;
+int g_async_stage_runs = 0;
+brave::ResponseCallback* g_pending_next_callback = nullptr;
+
+int SyncStage(const brave::ResponseCallback& next_callback,
+              std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  g_sync_stage_runs++;
+  return net::OK;
+}
+
+// Holds on to |next_callback| so the test decides when the stage finishes.
+int AsyncStage(const brave::ResponseCallback& next_callback,
+               std::shared_ptr<brave::BraveRequestInfo> ctx) {
+  g_async_stage_runs++;
+  *g_pending_next_callback = next_callback;
+  return net::ERR_IO_PENDING;
+}
+
+}  // namespace
+
+class BraveRequestHandlerTest : public testing::Test {
+ public:
+  BraveRequestHandlerTest() {
+    g_sync_stage_runs = 0;
+    g_async_stage_runs = 0;
+    g_pending_next_callback = &pending_next_callback_;
+  }
+  ~BraveRequestHandlerTest() override { g_pending_next_callback = nullptr; }
+
+ protected:
+  void CreateHandler(std::vector<BraveRequestHandler::Stage> stages) {
+    handler_ = std::make_unique<BraveRequestHandler>(std::move(stages));
+  }
+
+  // Starts the kOnBeforeStartTransaction stages for a new request and
+  // records when its completion callback runs.
+  int Start(std::shared_ptr<brave::BraveRequestInfo> ctx) {
+    return handler_->OnBeforeStartTransaction(
+        ctx, base::BindLambdaForTesting([this](int rv) {
+          completion_result_ = rv;
+          completion_runs_++;
+        }),
+        &headers_);
+  }
+
+  content::BrowserTaskEnvironment task_environment_;
+  net::HttpRequestHeaders headers_;
+  brave::ResponseCallback pending_next_callback_;
+  std::unique_ptr<BraveRequestHandler> handler_;
+  int completion_result_ = net::ERR_UNEXPECTED;
+  int completion_runs_ = 0;
+};
+
+TEST_F(BraveRequestHandlerTest, SynchronousStagesReturnResultDirectly) {
+  CreateHandler({{brave::kOnBeforeStartTransaction, &SyncStage},
+                 {brave::kOnBeforeStartTransaction, &SyncStage},
+                 {brave::kOnHeadersReceived, &SyncStage}});
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://example.com/"));
+
+  EXPECT_EQ(net::OK, Start(ctx));
+  // Only the stages for this event ran.
+  EXPECT_EQ(2, g_sync_stage_runs);
+
+  // Nothing is posted for a synchronous result.
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, completion_runs_);
+}
+
+TEST_F(BraveRequestHandlerTest, AsynchronousStageResumesPipeline) {
+  CreateHandler({{brave::kOnBeforeStartTransaction, &SyncStage},
+                 {brave::kOnBeforeStartTransaction, &AsyncStage},
+                 {brave::kOnBeforeStartTransaction, &SyncStage}});
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://example.com/"));
+
+  EXPECT_EQ(net::ERR_IO_PENDING, Start(ctx));
+  EXPECT_EQ(1, g_sync_stage_runs);
+  EXPECT_EQ(1, g_async_stage_runs);
+  ASSERT_TRUE(pending_next_callback_);
+
+  pending_next_callback_.Run();
+  // The remaining stage runs right away, the completion is posted.
+  EXPECT_EQ(2, g_sync_stage_runs);
+  EXPECT_EQ(0, completion_runs_);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, completion_runs_);
+  EXPECT_EQ(net::OK, completion_result_);
+}
+
+TEST_F(BraveRequestHandlerTest, DestroyedRequestStopsPipeline) {
+  CreateHandler({{brave::kOnBeforeStartTransaction, &AsyncStage},
+                 {brave::kOnBeforeStartTransaction, &SyncStage}});
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://example.com/"));
+
+  EXPECT_EQ(net::ERR_IO_PENDING, Start(ctx));
+  ASSERT_TRUE(pending_next_callback_);
+
+  handler_->OnURLRequestDestroyed(ctx);
+  pending_next_callback_.Run();
+  base::RunLoop().RunUntilIdle();
+
+  // The stages after the asynchronous one don't run and nothing is reported.
+  EXPECT_EQ(0, g_sync_stage_runs);
+  EXPECT_EQ(0, completion_runs_);
+}
+
+TEST_F(BraveRequestHandlerTest, DestroyedHandlerDropsPendingStage) {
+  CreateHandler({{brave::kOnBeforeStartTransaction, &AsyncStage},
+                 {brave::kOnBeforeStartTransaction, &SyncStage}});
+  auto ctx = std::make_shared<brave::BraveRequestInfo>(
+      GURL("https://example.com/"));
+
+  EXPECT_EQ(net::ERR_IO_PENDING, Start(ctx));
+  ASSERT_TRUE(pending_next_callback_);
+
+  handler_.reset();
+  pending_next_callback_.Run();
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(0, g_sync_stage_runs);
+  EXPECT_EQ(0, completion_runs_);
+}
@@ -0,0 +1,103 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_cache.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/memory/ptr_util.h"
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/browser/profiles/profile.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace brave {
+
+namespace {
+
+// User data key for ShieldsSettingsCache.
+const void* const kShieldsSettingsCacheUserDataKey =
+    &kShieldsSettingsCacheUserDataKey;
+
+bool AffectsSnapshots(ContentSettingsTypeSet content_type_set) {
+  if (content_type_set.ContainsAllTypes())
+    return true;
+  switch (content_type_set.GetType()) {
+    case ContentSettingsType::BRAVE_SHIELDS:
+    case ContentSettingsType::BRAVE_ADS:
+    case ContentSettingsType::BRAVE_TRACKERS:
+    case ContentSettingsType::BRAVE_COSMETIC_FILTERING:
+    case ContentSettingsType::BRAVE_HTTP_UPGRADABLE_RESOURCES:
+    case ContentSettingsType::BRAVE_REFERRERS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+ShieldsSettingsCache::ShieldsSettingsCache(
+    scoped_refptr<HostContentSettingsMap> map)
+    : map_(std::move(map)), snapshots_(kMaxCachedOrigins) {
+  observation_.Observe(map_.get());
+}
+
+ShieldsSettingsCache::~ShieldsSettingsCache() = default;
+
+// static
+ShieldsSettingsCache* ShieldsSettingsCache::GetForBrowserContext(
+    content::BrowserContext* browser_context) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  auto* self = static_cast<ShieldsSettingsCache*>(
+      browser_context->GetUserData(kShieldsSettingsCacheUserDataKey));
+  if (!self) {
+    self = new ShieldsSettingsCache(base::WrapRefCounted(
+        HostContentSettingsMapFactory::GetForProfile(
+            Profile::FromBrowserContext(browser_context))));
+    browser_context->SetUserData(kShieldsSettingsCacheUserDataKey,
+                                 base::WrapUnique(self));
+  }
+  return self;
+}
+
+ShieldsSettingsSnapshot ShieldsSettingsCache::Get(const GURL& tab_origin) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  auto it = snapshots_.Get(tab_origin);
+  if (it != snapshots_.end())
+    return it->second;
+
+  HostContentSettingsMap* map = map_.get();
+  ShieldsSettingsSnapshot snapshot;
+  snapshot.allow_brave_shields =
+      brave_shields::GetBraveShieldsEnabled(map, tab_origin);
+  snapshot.allow_ads = brave_shields::GetAdControlType(map, tab_origin) ==
+                       brave_shields::ControlType::ALLOW;
+  // Currently, "aggressive" mode is registered as a cosmetic filtering control
+  // type, even though it can also affect network blocking.
+  snapshot.aggressive_blocking =
+      brave_shields::GetCosmeticFilteringControlType(map, tab_origin) ==
+      brave_shields::ControlType::BLOCK;
+  snapshot.allow_http_upgradable_resource =
+      !brave_shields::GetHTTPSEverywhereEnabled(map, tab_origin);
+  snapshot.allow_referrers =
+      brave_shields::AreReferrersAllowed(map, tab_origin);
+  snapshots_.Put(tab_origin, snapshot);
+  return snapshot;
+}
+
+void ShieldsSettingsCache::OnContentSettingChanged(
+    const ContentSettingsPattern& primary_pattern,
+    const ContentSettingsPattern& secondary_pattern,
+    ContentSettingsTypeSet content_type_set) {
+  if (AffectsSnapshots(content_type_set))
+    snapshots_.Clear();
+}
+
+}  // namespace brave
@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/browser/net/shields_settings_cache.h"
+
+#include "brave/components/brave_shields/browser/brave_shields_util.h"
+#include "chrome/browser/content_settings/host_content_settings_map_factory.h"
+#include "chrome/test/base/scoped_testing_local_state.h"
+#include "chrome/test/base/testing_browser_process.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+class ShieldsSettingsCacheTest : public testing::Test {
+ public:
+  ShieldsSettingsCacheTest()
+      : local_state_(TestingBrowserProcess::GetGlobal()) {}
+
+ protected:
+  HostContentSettingsMap* map() {
+    return HostContentSettingsMapFactory::GetForProfile(&profile_);
+  }
+
+  ShieldsSettingsCache* cache() {
+    return ShieldsSettingsCache::GetForBrowserContext(&profile_);
+  }
+
+  PrefService* local_state() { return local_state_.Get(); }
+
+ private:
+  content::BrowserTaskEnvironment task_environment_;
+  ScopedTestingLocalState local_state_;
+  TestingProfile profile_;
+};
+
+TEST_F(ShieldsSettingsCacheTest, ReturnsOnePerProfile) {
+  EXPECT_EQ(cache(), cache());
+}
+
+TEST_F(ShieldsSettingsCacheTest, MatchesContentSettings) {
+  const GURL url("https://brave.com");
+  brave_shields::SetAdControlType(map(), brave_shields::ControlType::ALLOW,
+                                  url, local_state());
+
+  ShieldsSettingsSnapshot snapshot = cache()->Get(url);
+  EXPECT_TRUE(snapshot.allow_brave_shields);
+  EXPECT_TRUE(snapshot.allow_ads);
+  EXPECT_EQ(brave_shields::AreReferrersAllowed(map(), url),
+            snapshot.allow_referrers);
+  EXPECT_EQ(!brave_shields::GetHTTPSEverywhereEnabled(map(), url),
+            snapshot.allow_http_upgradable_resource);
+
+  // Other origins keep the defaults.
+  EXPECT_FALSE(cache()->Get(GURL("https://example.com")).allow_ads);
+}
+
+TEST_F(ShieldsSettingsCacheTest, InvalidatedWhenSettingsChange) {
+  const GURL url("https://brave.com");
+  EXPECT_TRUE(cache()->Get(url).allow_brave_shields);
+  EXPECT_FALSE(cache()->Get(url).aggressive_blocking);
+
+  brave_shields::SetBraveShieldsEnabled(map(), false, url, local_state());
+  EXPECT_FALSE(cache()->Get(url).allow_brave_shields);
+
+  brave_shields::SetCosmeticFilteringControlType(
+      map(), brave_shields::ControlType::BLOCK, url, local_state());
+  EXPECT_TRUE(cache()->Get(url).aggressive_blocking);
+
+  brave_shields::SetBraveShieldsEnabled(map(), true, url, local_state());
+  EXPECT_TRUE(cache()->Get(url).allow_brave_shields);
+}
+
+}  // namespace brave
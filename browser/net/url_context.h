@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "net/base/completion_once_callback.h"
 #include "net/base/network_anonymization_key.h"
 #include "net/http/http_request_headers.h"
 #include "net/http/http_response_headers.h"
@@ -87,6 +88,7 @@ struct BraveRequestInfo {
   bool is_webtorrent_disabled = false;
   int frame_tree_node_id = 0;
   uint64_t request_identifier = 0;
+  // Index of the next BraveRequestHandler stage to run for |event_type|.
   size_t next_url_request_index = 0;
 
   content::BrowserContext* browser_context = nullptr;
@@ -136,23 +138,11 @@ struct BraveRequestInfo {
   friend class ::BraveRequestHandler;
 
   GURL* new_url = nullptr;
+  // Completion callback of the pipeline in progress for this request, reset
+  // once it has run or the request is destroyed.
+  net::CompletionOnceCallback completion_callback;
 };
 
-// ResponseListener
-using OnBeforeURLRequestCallback =
-    base::RepeatingCallback<int(const ResponseCallback& next_callback,
-                                std::shared_ptr<BraveRequestInfo> ctx)>;
-using OnBeforeStartTransactionCallback =
-    base::RepeatingCallback<int(net::HttpRequestHeaders* headers,
-                                const ResponseCallback& next_callback,
-                                std::shared_ptr<BraveRequestInfo> ctx)>;
-using OnHeadersReceivedCallback = base::RepeatingCallback<int(
-    const net::HttpResponseHeaders* original_response_headers,
-    scoped_refptr<net::HttpResponseHeaders>* override_response_headers,
-    GURL* allowed_unsafe_redirect_url,
-    const ResponseCallback& next_callback,
-    std::shared_ptr<BraveRequestInfo> ctx)>;
-
 }  // namespace brave
 
 #endif  // BRAVE_BROWSER_NET_URL_CONTEXT_H_
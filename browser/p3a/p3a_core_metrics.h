@@ -48,6 +48,8 @@ class BraveUptimeTracker {
   resource_coordinator::UsageClock usage_clock_;
   base::RepeatingTimer timer_;
   base::TimeDelta current_total_usage_;
+  // Saved on every update rather than deferred, as the tracker is leaked and
+  // would never flush a pending write.
   WeeklyStorage state_;
 };
 
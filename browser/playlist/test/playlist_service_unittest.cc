@@ -5,15 +5,23 @@
 
 #include "brave/components/playlist/playlist_service.h"
 
+#include <atomic>
+
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
 #include "base/test/bind.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/threading/thread_restrictions.h"
 #include "base/timer/timer.h"
 #include "brave/browser/playlist/playlist_service_factory.h"
 #include "brave/components/playlist/features.h"
 #include "brave/components/playlist/media_detector_component_manager.h"
+#include "brave/components/playlist/playlist_media_file_download_manager.h"
 #include "brave/components/playlist/playlist_constants.h"
 #include "brave/components/playlist/playlist_service_helper.h"
 #include "brave/components/playlist/playlist_service_observer.h"
@@ -28,6 +36,7 @@
 #include "content/public/test/browser_task_environment.h"
 #include "content/public/test/test_host_resolver.h"
 #include "net/dns/mock_host_resolver.h"
+#include "net/http/http_request_headers.h"
 #include "net/test/embedded_test_server/embedded_test_server.h"
 #include "net/test/embedded_test_server/http_request.h"
 #include "net/test/embedded_test_server/http_response.h"
@@ -39,6 +48,15 @@ namespace {
 
 std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
     const net::test_server::HttpRequest& request) {
+  if (request.relative_url == "/empty_response_media_file") {
+    // Closes the connection before sending any headers.
+    return std::make_unique<net::test_server::RawHttpResponse>("", "");
+  }
+  if (base::StartsWith(request.relative_url, "/hung_media_file")) {
+    // Never answers, so that downloads of it stay in progress.
+    return std::make_unique<net::test_server::HungResponse>();
+  }
+
   auto http_response = std::make_unique<net::test_server::BasicHttpResponse>();
   if (request.relative_url == "/valid_thumbnail" ||
       request.relative_url == "/valid_media_file_1" ||
@@ -46,6 +64,46 @@ std::unique_ptr<net::test_server::HttpResponse> HandleRequest(
     http_response->set_code(net::HTTP_OK);
     http_response->set_content_type("image/gif");
     http_response->set_content("thumbnail");
+  } else if (request.relative_url == "/resumable_media_file") {
+    // Serves "0123456789" and honors open-ended "bytes=N-" ranges, as long as
+    // If-Range matches its ETag.
+    const std::string content = "0123456789";
+    const std::string etag = "\"v1\"";
+    http_response->set_content_type("video/mp4");
+    http_response->AddCustomHeader("ETag", etag);
+    auto range = request.headers.find(net::HttpRequestHeaders::kRange);
+    auto if_range = request.headers.find(net::HttpRequestHeaders::kIfRange);
+    size_t offset = 0;
+    if (range != request.headers.end() && if_range != request.headers.end() &&
+        if_range->second == etag &&
+        base::StartsWith(range->second, "bytes=") &&
+        base::StringToSizeT(
+            base::TrimString(range->second.substr(6), "-", base::TRIM_TRAILING),
+            &offset) &&
+        offset < content.size()) {
+      http_response->set_code(net::HTTP_PARTIAL_CONTENT);
+      http_response->AddCustomHeader(
+          "Content-Range",
+          base::StringPrintf("bytes %zu-%zu/%zu", offset, content.size() - 1,
+                             content.size()));
+      http_response->set_content(content.substr(offset));
+    } else {
+      http_response->set_code(net::HTTP_OK);
+      http_response->set_content(content);
+    }
+  } else if (request.relative_url == "/misaligned_range_media_file") {
+    // Answers every range request with the whole file as a 206.
+    const std::string content = "0123456789";
+    http_response->set_content_type("video/mp4");
+    http_response->AddCustomHeader("ETag", "\"v1\"");
+    if (request.headers.find(net::HttpRequestHeaders::kRange) !=
+        request.headers.end()) {
+      http_response->set_code(net::HTTP_PARTIAL_CONTENT);
+      http_response->AddCustomHeader("Content-Range", "bytes 0-9/10");
+    } else {
+      http_response->set_code(net::HTTP_OK);
+    }
+    http_response->set_content(content);
   } else {
     http_response->set_code(net::HTTP_NOT_FOUND);
   }
@@ -139,6 +197,77 @@ class PlaylistServiceUnitTest : public testing::Test {
     return params;
   }
 
+  // Leaves behind "abcde" as an interrupted download of item |id| with
+  // |validator| would, and returns the path of the partial file.
+  base::FilePath WritePartialFile(const std::string& id,
+                                  const std::string& validator) {
+    auto* service = playlist_service();
+
+    base::FilePath media_path;
+    EXPECT_TRUE(service->GetMediaPath(id, &media_path));
+    const base::FilePath partial_path =
+        media_path.AddExtension(FILE_PATH_LITERAL(".partial"));
+
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    EXPECT_TRUE(base::CreateDirectory(service->GetPlaylistItemDirPath(id)));
+    EXPECT_TRUE(base::WriteFile(partial_path, "abcde"));
+    EXPECT_TRUE(base::WriteFile(
+        partial_path.AddExtension(FILE_PATH_LITERAL(".validator")),
+        validator));
+    return partial_path;
+  }
+
+  // Creates an item with a partial file, as WritePartialFile() does, whose
+  // media file is served at |relative_url|, and waits for its download to
+  // end with |result|.
+  void CreateItemWithPartialFile(const std::string& id,
+                                 const std::string& relative_url,
+                                 const std::string& validator,
+                                 PlaylistChangeParams::Type result) {
+    auto* service = playlist_service();
+    WritePartialFile(id, validator);
+
+    bool done = false;
+    testing::NiceMock<MockObserver> observer;
+    EXPECT_CALL(observer,
+                OnPlaylistStatusChanged(PlaylistChangeParams(result, id)))
+        .WillOnce([&]() { done = true; });
+    service->AddObserver(&observer);
+
+    auto params = GetValidCreateParams();
+    params.id = id;
+    params.media_src = params.media_file_path =
+        https_server()->GetURL(relative_url).spec();
+    service->CreatePlaylistItem(params);
+
+    WaitUntil(base::BindLambdaForTesting([&]() { return done; }));
+    service->RemoveObserver(&observer);
+  }
+
+  // Downloads |relative_url| on top of a partial file, as
+  // CreateItemWithPartialFile() does, and returns the resulting media file.
+  std::string DownloadWithPartialFile(const std::string& relative_url,
+                                      const std::string& validator) {
+    auto id = base::Token::CreateRandom().ToString();
+    CreateItemWithPartialFile(id, relative_url, validator,
+                              PlaylistChangeParams::Type::kItemCached);
+
+    base::FilePath media_path;
+    EXPECT_TRUE(playlist_service()->GetMediaPath(id, &media_path));
+    const base::FilePath partial_path =
+        media_path.AddExtension(FILE_PATH_LITERAL(".partial"));
+
+    base::ScopedAllowBlockingForTesting allow_blocking;
+    std::string content;
+    EXPECT_TRUE(base::ReadFileToString(media_path, &content));
+    EXPECT_FALSE(base::PathExists(partial_path));
+    EXPECT_FALSE(base::PathExists(
+        partial_path.AddExtension(FILE_PATH_LITERAL(".validator"))));
+    return content;
+  }
+
+  int hung_media_requests_count() const { return hung_media_requests_count_; }
+
   // testing::Test:
   void SetUp() override {
     testing::Test::SetUp();
@@ -175,6 +304,11 @@ class PlaylistServiceUnitTest : public testing::Test {
     https_server_ = std::make_unique<net::EmbeddedTestServer>(
         net::test_server::EmbeddedTestServer::TYPE_HTTP);
     https_server_->RegisterRequestHandler(base::BindRepeating(&HandleRequest));
+    https_server_->RegisterRequestMonitor(base::BindLambdaForTesting(
+        [this](const net::test_server::HttpRequest& request) {
+          if (base::StartsWith(request.relative_url, "/hung_media_file"))
+            hung_media_requests_count_++;
+        }));
     ASSERT_TRUE(https_server_->Start());
   }
 
@@ -203,6 +337,9 @@ class PlaylistServiceUnitTest : public testing::Test {
 
   std::unique_ptr<net::EmbeddedTestServer> https_server_;
   std::unique_ptr<content::TestHostResolver> host_resolver_;
+
+  // Updated on the test server's thread.
+  std::atomic<int> hung_media_requests_count_{0};
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -316,6 +453,78 @@ TEST_F(PlaylistServiceUnitTest, MediaDownloadFailed) {
   service->RemoveObserver(&observer);
 }
 
+TEST_F(PlaylistServiceUnitTest, MediaDownloadResumesFromPartialFile) {
+  // The partial file's content differs from the remote one so that we can
+  // tell whether only the remaining range was fetched.
+  EXPECT_EQ("abcde56789",
+            DownloadWithPartialFile("/resumable_media_file", "\"v1\""));
+}
+
+TEST_F(PlaylistServiceUnitTest, MediaDownloadRestartsIfRemoteFileChanged) {
+  // The validator doesn't match, so the server sends the whole file.
+  EXPECT_EQ("0123456789",
+            DownloadWithPartialFile("/resumable_media_file", "\"v0\""));
+}
+
+TEST_F(PlaylistServiceUnitTest, MediaDownloadRestartsOnMisalignedRange) {
+  // The returned range starts at 0 rather than after the partial file, so
+  // the partial file is dropped and the download starts over.
+  EXPECT_EQ("0123456789", DownloadWithPartialFile(
+                              "/misaligned_range_media_file", "\"v1\""));
+}
+
+TEST_F(PlaylistServiceUnitTest, MediaDownloadKeepsPartialFileWithoutResponse) {
+  // The connection is dropped before any headers arrive, which doesn't tell
+  // whether the partial file is still valid, so it's kept for the next try.
+  auto id = base::Token::CreateRandom().ToString();
+  CreateItemWithPartialFile(id, "/empty_response_media_file", "\"v1\"",
+                            PlaylistChangeParams::Type::kItemAborted);
+
+  base::FilePath media_path;
+  ASSERT_TRUE(playlist_service()->GetMediaPath(id, &media_path));
+  const base::FilePath partial_path =
+      media_path.AddExtension(FILE_PATH_LITERAL(".partial"));
+
+  base::ScopedAllowBlockingForTesting allow_blocking;
+  std::string content;
+  EXPECT_TRUE(base::ReadFileToString(partial_path, &content));
+  EXPECT_EQ("abcde", content);
+  EXPECT_TRUE(base::ReadFileToString(
+      partial_path.AddExtension(FILE_PATH_LITERAL(".validator")), &content));
+  EXPECT_EQ("\"v1\"", content);
+  EXPECT_FALSE(base::PathExists(
+      partial_path.AddExtension(FILE_PATH_LITERAL(".range"))));
+  EXPECT_FALSE(base::PathExists(media_path));
+}
+
+TEST_F(PlaylistServiceUnitTest, MediaFilesAreDownloadedConcurrently) {
+  // None of the downloads ever finishes, so all of the requests can only
+  // reach the server if they're in flight at once. One more item than can be
+  // downloaded at a time is created, and it should wait for a free slot.
+  constexpr int kMaxConcurrentDownloads = static_cast<int>(
+      PlaylistMediaFileDownloadManager::kDefaultMaxConcurrentDownloads);
+  auto* service = playlist_service();
+  for (int i = 0; i <= kMaxConcurrentDownloads; i++) {
+    auto params = GetValidCreateParams();
+    params.id = base::Token::CreateRandom().ToString();
+    params.media_src = params.media_file_path =
+        https_server()
+            ->GetURL(base::StringPrintf("/hung_media_file_%d", i))
+            .spec();
+    service->CreatePlaylistItem(params);
+  }
+
+  WaitUntil(base::BindLambdaForTesting([&]() {
+    return hung_media_requests_count() == kMaxConcurrentDownloads;
+  }));
+
+  base::RunLoop run_loop;
+  base::SequencedTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE, run_loop.QuitClosure(), base::Milliseconds(500));
+  run_loop.Run();
+  EXPECT_EQ(kMaxConcurrentDownloads, hung_media_requests_count());
+}
+
 TEST_F(PlaylistServiceUnitTest, MediaRecoverTest) {
   auto* service = playlist_service();
 
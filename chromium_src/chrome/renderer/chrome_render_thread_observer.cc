@@ -0,0 +1,19 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at https://mozilla.org/MPL/2.0/. */
+
+#include "chrome/renderer/chrome_render_thread_observer.h"
+
+#include "brave/components/content_settings/renderer/brave_content_settings_agent_impl.h"
+
+#define SetContentSettingRules SetContentSettingRules_ChromiumImpl
+#include "src/chrome/renderer/chrome_render_thread_observer.cc"
+#undef SetContentSettingRules
+
+void ChromeRenderThreadObserver::SetContentSettingRules(
+    const RendererContentSettingRules& rules) {
+  SetContentSettingRules_ChromiumImpl(rules);
+  content_settings::BraveContentSettingsAgentImpl::
+      OnContentSettingRulesUpdated();
+}
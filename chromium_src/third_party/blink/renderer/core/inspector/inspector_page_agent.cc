@@ -32,6 +32,65 @@ Response InspectorPageAgent::generatePageGraph(String* data) {
 #endif  // BUILDFLAG(ENABLE_BRAVE_PAGE_GRAPH)
 }
 
+Response InspectorPageAgent::generatePageGraphChunk(
+    protocol::Maybe<String> cursor,
+    protocol::Maybe<int> chunk_size,
+    String* data,
+    protocol::Maybe<String>* next_cursor) {
+#if BUILDFLAG(ENABLE_BRAVE_PAGE_GRAPH)
+  constexpr int kDefaultChunkSize = 1 << 20;
+  constexpr int kMaxChunkSize = 16 << 20;
+  if (chunk_size.isJust() &&
+      (chunk_size.fromJust() <= 0 || chunk_size.fromJust() > kMaxChunkSize)) {
+    return Response::InvalidParams("chunkSize is out of range");
+  }
+
+  LocalFrame* main_frame = inspected_frames_->Root();
+  if (!main_frame) {
+    return Response::ServerError("No main frame found");
+  }
+
+  PageGraph* page_graph = blink::PageGraph::From(*main_frame);
+  if (!page_graph) {
+    return Response::ServerError("No Page Graph for main frame");
+  }
+
+  // The cursor is "<node count>,<edge count>,<next item>".
+  PageGraph::GraphMLPageCursor graphml_cursor;
+  if (cursor.isJust()) {
+    Vector<String> parts;
+    cursor.fromJust().Split(',', parts);
+    bool ok = parts.size() == 3;
+    if (ok) {
+      graphml_cursor.node_count = parts[0].ToUInt64Strict(&ok);
+    }
+    if (ok) {
+      graphml_cursor.edge_count = parts[1].ToUInt64Strict(&ok);
+    }
+    if (ok) {
+      graphml_cursor.next_item = parts[2].ToUInt64Strict(&ok);
+    }
+    if (!ok || graphml_cursor.IsDone() ||
+        !page_graph->IsValidGraphMLPageCursor(graphml_cursor)) {
+      return Response::InvalidParams("Invalid cursor");
+    }
+  } else {
+    graphml_cursor = page_graph->CreateGraphMLPageCursor();
+  }
+
+  *data = String::FromUTF8(page_graph->GenerateGraphMLPage(
+      chunk_size.fromMaybe(kDefaultChunkSize), &graphml_cursor));
+  if (!graphml_cursor.IsDone()) {
+    *next_cursor = String::Format(
+        "%zu,%zu,%zu", graphml_cursor.node_count, graphml_cursor.edge_count,
+        graphml_cursor.next_item);
+  }
+  return Response::Success();
+#else
+  return Response::ServerError("Page Graph buildflag is disabled");
+#endif  // BUILDFLAG(ENABLE_BRAVE_PAGE_GRAPH)
+}
+
 Response InspectorPageAgent::generatePageGraphNodeReport(
     int node_id,
     std::unique_ptr<protocol::Array<String>>* report) {
@@ -11,6 +11,9 @@
 #define clearCompilationCache                                                  \
   NotUsed();                                                                   \
   protocol::Response generatePageGraph(String* data) override;                 \
+  protocol::Response generatePageGraphChunk(                                   \
+      protocol::Maybe<String> cursor, protocol::Maybe<int> chunk_size,         \
+      String* data, protocol::Maybe<String>* next_cursor) override;            \
   protocol::Response generatePageGraphNodeReport(                              \
       int node_id, std::unique_ptr<protocol::Array<String>>* report) override; \
   protocol::Response clearCompilationCache
@@ -42,6 +42,12 @@ void AsyncDataStore::LoadTrainingData(
   data_store_.AsyncCall(&DataStore::LoadTrainingData).Then(std::move(callback));
 }
 
+void AsyncDataStore::LoadTrainingColumns(
+    base::OnceCallback<void(TrainingColumns)> callback) {
+  data_store_.AsyncCall(&DataStore::LoadTrainingColumns)
+      .Then(std::move(callback));
+}
+
 void AsyncDataStore::PurgeTrainingDataAfterExpirationDate() {
   data_store_.AsyncCall(&DataStore::PurgeTrainingDataAfterExpirationDate);
 }
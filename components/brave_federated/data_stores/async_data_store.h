@@ -32,6 +32,7 @@ class AsyncDataStore {
       std::vector<brave_federated::mojom::CovariateInfoPtr> training_instance,
       base::OnceCallback<void(bool)> callback);
   void LoadTrainingData(base::OnceCallback<void(TrainingData)> callback);
+  void LoadTrainingColumns(base::OnceCallback<void(TrainingColumns)> callback);
   void PurgeTrainingDataAfterExpirationDate();
 
  private:
@@ -5,6 +5,7 @@
 
 #include "brave/components/brave_federated/data_stores/data_store.h"
 
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
@@ -45,24 +46,49 @@ void DatabaseErrorCallback(sql::Database* db,
     DLOG(FATAL) << db->GetErrorMessage();
 }
 
+// Number of covariates written by one multi-row INSERT. Instances with fewer
+// remaining covariates fall back to single-row inserts, so that only two
+// statements need to be cached.
+constexpr size_t kCovariatesPerInsert = 16;
+constexpr int kColumnsPerCovariate = 5;
+
+std::string BuildInsertCovariatesSql(const std::string& table_name,
+                                     size_t row_count) {
+  DCHECK_GT(row_count, 0u);
+  std::string sql = base::StringPrintf(
+      "INSERT INTO %s (training_instance_id, feature_name, feature_type, "
+      "feature_value, created_at) VALUES (?,?,?,?,?)",
+      table_name.c_str());
+  for (size_t i = 1; i < row_count; ++i) {
+    sql += ",(?,?,?,?,?)";
+  }
+  return sql;
+}
+
 void BindCovariateToStatement(
     const brave_federated::mojom::CovariateInfo& covariate,
     int training_instance_id,
     base::Time created_at,
+    int first_param,
     sql::Statement* stmt) {
   DCHECK(stmt);
 
-  stmt->BindInt(0, training_instance_id);
-  stmt->BindInt(1, static_cast<int>(covariate.type));
-  stmt->BindInt(2, static_cast<int>(covariate.data_type));
-  stmt->BindString(3, covariate.value);
-  stmt->BindDouble(4, created_at.ToDoubleT());
+  stmt->BindInt(first_param, training_instance_id);
+  stmt->BindInt(first_param + 1, static_cast<int>(covariate.type));
+  stmt->BindInt(first_param + 2, static_cast<int>(covariate.data_type));
+  stmt->BindString(first_param + 3, covariate.value);
+  stmt->BindDouble(first_param + 4, created_at.ToDoubleT());
 }
 
 }  // namespace
 
 namespace brave_federated {
 
+TrainingColumns::TrainingColumns() = default;
+TrainingColumns::TrainingColumns(TrainingColumns&&) = default;
+TrainingColumns& TrainingColumns::operator=(TrainingColumns&&) = default;
+TrainingColumns::~TrainingColumns() = default;
+
 DataStore::DataStore(const DataStoreTask data_store_task,
                      const base::FilePath& db_file_path)
     : database_(
@@ -85,7 +111,8 @@ bool DataStore::InitializeDatabase() {
 }
 
 int DataStore::GetNextTrainingInstanceId() {
-  sql::Statement statement(database_.GetUniqueStatement(
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf("SELECT MAX(training_instance_id) FROM %s",
                          data_store_task_.name.c_str())
           .c_str()));
@@ -100,39 +127,76 @@ void DataStore::SaveCovariate(
     const brave_federated::mojom::CovariateInfo& covariate,
     int training_instance_id,
     const base::Time created_at) {
-  sql::Statement statement(database_.GetUniqueStatement(
-      base::StringPrintf("INSERT INTO %s (training_instance_id, "
-                         "feature_name, feature_type, "
-                         "feature_value, created_at) "
-                         "VALUES (?,?,?,?,?)",
-                         data_store_task_.name.c_str())
-          .c_str()));
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
+      BuildInsertCovariatesSql(data_store_task_.name, 1).c_str()));
 
-  BindCovariateToStatement(covariate, training_instance_id, created_at,
+  BindCovariateToStatement(covariate, training_instance_id, created_at, 0,
                            &statement);
   statement.Run();
 }
 
+bool DataStore::InsertCovariates(
+    std::vector<mojom::CovariateInfoPtr>::const_iterator first,
+    size_t count,
+    int training_instance_id,
+    base::Time created_at) {
+  DCHECK(count == 1 || count == kCovariatesPerInsert);
+
+  sql::Statement statement;
+  if (count == kCovariatesPerInsert) {
+    statement.Assign(database_.GetCachedStatement(
+        SQL_FROM_HERE,
+        BuildInsertCovariatesSql(data_store_task_.name, kCovariatesPerInsert)
+            .c_str()));
+  } else {
+    statement.Assign(database_.GetCachedStatement(
+        SQL_FROM_HERE,
+        BuildInsertCovariatesSql(data_store_task_.name, 1).c_str()));
+  }
+
+  for (size_t i = 0; i < count; ++i, ++first) {
+    BindCovariateToStatement(**first, training_instance_id, created_at,
+                             static_cast<int>(i) * kColumnsPerCovariate,
+                             &statement);
+  }
+  return statement.Run();
+}
+
 bool DataStore::AddTrainingInstance(
     const std::vector<brave_federated::mojom::CovariateInfoPtr>
         training_instance) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+  sql::Transaction transaction(&database_);
+  if (!transaction.Begin()) {
+    return false;
+  }
+
   const int training_instance_id = GetNextTrainingInstanceId();
   const base::Time created_at = base::Time::Now();
 
-  for (const auto& covariate : training_instance) {
-    SaveCovariate(*covariate, training_instance_id, created_at);
+  auto it = training_instance.cbegin();
+  while (it != training_instance.cend()) {
+    const size_t remaining =
+        static_cast<size_t>(training_instance.cend() - it);
+    const size_t count =
+        remaining >= kCovariatesPerInsert ? kCovariatesPerInsert : 1;
+    if (!InsertCovariates(it, count, training_instance_id, created_at)) {
+      return false;
+    }
+    it += count;
   }
 
-  return true;
+  return transaction.Commit();
 }
 
 TrainingData DataStore::LoadTrainingData() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   TrainingData training_instances;
-  sql::Statement statement(database_.GetUniqueStatement(
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
       base::StringPrintf("SELECT id, training_instance_id, feature_name, "
                          "feature_type, feature_value FROM %s",
                          data_store_task_.name.c_str())
@@ -152,6 +216,43 @@ TrainingData DataStore::LoadTrainingData() {
   return training_instances;
 }
 
+TrainingColumns DataStore::LoadTrainingColumns() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  TrainingColumns columns;
+  sql::Statement count_statement(database_.GetCachedStatement(
+      SQL_FROM_HERE, base::StringPrintf("SELECT COUNT(*) FROM %s",
+                                        data_store_task_.name.c_str())
+                         .c_str()));
+  if (!count_statement.Step()) {
+    return columns;
+  }
+  const size_t row_count =
+      base::checked_cast<size_t>(count_statement.ColumnInt64(0));
+  columns.training_instance_ids.reserve(row_count);
+  columns.types.reserve(row_count);
+  columns.data_types.reserve(row_count);
+  columns.values.reserve(row_count);
+
+  sql::Statement statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
+      base::StringPrintf("SELECT training_instance_id, feature_name, "
+                         "feature_type, feature_value FROM %s "
+                         "ORDER BY training_instance_id, id",
+                         data_store_task_.name.c_str())
+          .c_str()));
+  while (statement.Step()) {
+    columns.training_instance_ids.push_back(statement.ColumnInt(0));
+    columns.types.push_back(
+        static_cast<mojom::CovariateType>(statement.ColumnInt(1)));
+    columns.data_types.push_back(
+        static_cast<mojom::DataType>(statement.ColumnInt(2)));
+    columns.values.push_back(statement.ColumnString(3));
+  }
+
+  return columns;
+}
+
 bool DataStore::DeleteTrainingData() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -167,9 +268,14 @@ bool DataStore::DeleteTrainingData() {
 void DataStore::PurgeTrainingDataAfterExpirationDate() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  sql::Statement delete_statement(database_.GetUniqueStatement(
-      base::StringPrintf(" DELETE FROM %s WHERE created_at < ? OR id NOT IN "
-                         "(SELECT id FROM %s ORDER BY id DESC LIMIT ?)",
+  // Ids only grow, so everything at or below the id of the first record past
+  // the newest |max_number_of_records| ones is over the limit. Both sides of
+  // the OR are answered from an index.
+  sql::Statement delete_statement(database_.GetCachedStatement(
+      SQL_FROM_HERE,
+      base::StringPrintf("DELETE FROM %s WHERE created_at < ? OR id <= "
+                         "(SELECT id FROM %s ORDER BY id DESC LIMIT 1 "
+                         "OFFSET ?)",
                          data_store_task_.name.c_str(),
                          data_store_task_.name.c_str())
           .c_str()));
@@ -181,19 +287,37 @@ void DataStore::PurgeTrainingDataAfterExpirationDate() {
 }
 
 bool DataStore::MaybeCreateTable() {
-  if (database_.DoesTableExist(data_store_task_.name)) {
-    return true;
-  }
+  const char* table_name = data_store_task_.name.c_str();
 
   sql::Transaction transaction(&database_);
-  return transaction.Begin() &&
+  if (!transaction.Begin()) {
+    return false;
+  }
+
+  if (!database_.DoesTableExist(data_store_task_.name) &&
+      !database_.Execute(
+          base::StringPrintf(
+              "CREATE TABLE %s (id INTEGER PRIMARY KEY AUTOINCREMENT, "
+              "training_instance_id INTEGER NOT NULL, feature_name INTEGER "
+              "NOT NULL, feature_type INTEGER NOT NULL, "
+              "feature_value TEXT NOT NULL, created_at DOUBLE NOT NULL)",
+              table_name)
+              .c_str())) {
+    return false;
+  }
+
+  // Created separately so that databases from before they existed get them
+  // too.
+  return database_.Execute(
+             base::StringPrintf("CREATE INDEX IF NOT EXISTS "
+                                "%s_created_at_index ON %s (created_at)",
+                                table_name, table_name)
+                 .c_str()) &&
          database_.Execute(
              base::StringPrintf(
-                 "CREATE TABLE %s (id INTEGER PRIMARY KEY AUTOINCREMENT, "
-                 "training_instance_id INTEGER NOT NULL, feature_name INTEGER "
-                 "NOT NULL, feature_type INTEGER NOT NULL, "
-                 "feature_value TEXT NOT NULL, created_at DOUBLE NOT NULL)",
-                 data_store_task_.name.c_str())
+                 "CREATE INDEX IF NOT EXISTS %s_training_instance_id_index "
+                 "ON %s (training_instance_id)",
+                 table_name, table_name)
                  .c_str()) &&
          transaction.Commit();
 }
@@ -19,6 +19,20 @@ namespace brave_federated {
 
 using TrainingData = base::flat_map<int, std::vector<mojom::CovariateInfoPtr>>;
 
+// Training data as parallel columns with one entry per stored covariate,
+// ordered by training instance.
+struct TrainingColumns {
+  TrainingColumns();
+  TrainingColumns(TrainingColumns&&);
+  TrainingColumns& operator=(TrainingColumns&&);
+  ~TrainingColumns();
+
+  std::vector<int> training_instance_ids;
+  std::vector<mojom::CovariateType> types;
+  std::vector<mojom::DataType> data_types;
+  std::vector<std::string> values;
+};
+
 struct DataStoreTask {
   int id = 0;
   const std::string name;
@@ -47,6 +61,7 @@ class DataStore {
 
   bool DeleteTrainingData();
   TrainingData LoadTrainingData();
+  TrainingColumns LoadTrainingColumns();
   void PurgeTrainingDataAfterExpirationDate();
 
  protected:
@@ -58,6 +73,12 @@ class DataStore {
 
  private:
   bool MaybeCreateTable();
+  // Inserts |count| covariates starting at |first| with a single statement.
+  bool InsertCovariates(
+      std::vector<mojom::CovariateInfoPtr>::const_iterator first,
+      size_t count,
+      int training_instance_id,
+      base::Time created_at);
 
   SEQUENCE_CHECKER(sequence_checker_);
 };
@@ -10,6 +10,7 @@
 #include "base/check.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/path_service.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "brave/components/brave_federated/data_stores/data_store.h"
 #include "content/public/test/browser_task_environment.h"
@@ -192,4 +193,68 @@ TEST_F(DataStoreTest, PurgeTrainingDataAfterExpirationDate) {
   EXPECT_EQ(0, RecordCount());
 }
 
+TEST_F(DataStoreTest, AddTrainingInstanceWithManyCovariates) {
+  std::vector<mojom::CovariateInfoPtr> covariates;
+  for (int i = 0; i < 37; ++i) {
+    mojom::CovariateInfoPtr covariate = mojom::CovariateInfo::New();
+    covariate->type = (mojom::CovariateType)(i % 2);
+    covariate->data_type = mojom::DataType::kInt;
+    covariate->value = base::NumberToString(i);
+    covariates.push_back(std::move(covariate));
+  }
+
+  EXPECT_TRUE(AddTrainingInstance(std::move(covariates)));
+  EXPECT_EQ(37, RecordCount());
+  EXPECT_EQ(1, TrainingInstanceCount());
+
+  TrainingColumns columns = data_store_->LoadTrainingColumns();
+  ASSERT_EQ(37u, columns.values.size());
+  for (int i = 0; i < 37; ++i) {
+    EXPECT_EQ(base::NumberToString(i), columns.values[i]);
+  }
+}
+
+TEST_F(DataStoreTest, LoadTrainingColumns) {
+  InitializeDataStore();
+
+  TrainingColumns columns = data_store_->LoadTrainingColumns();
+  const size_t record_count = sizeof(kTrainingData) / sizeof(kTrainingData[0]);
+  ASSERT_EQ(record_count, columns.training_instance_ids.size());
+  ASSERT_EQ(record_count, columns.types.size());
+  ASSERT_EQ(record_count, columns.data_types.size());
+  ASSERT_EQ(record_count, columns.values.size());
+
+  for (size_t i = 0; i < record_count; ++i) {
+    // Training instance ids are assigned starting at 1.
+    EXPECT_EQ(kTrainingData[i].training_instance_id + 1,
+              columns.training_instance_ids[i]);
+    EXPECT_EQ(kTrainingData[i].feature_name,
+              static_cast<int>(columns.types[i]));
+    EXPECT_EQ(kTrainingData[i].feature_type,
+              static_cast<int>(columns.data_types[i]));
+    EXPECT_EQ(kTrainingData[i].feature_value, columns.values[i]);
+  }
+}
+
+TEST_F(DataStoreTest, PurgeTrainingDataOverMaxNumberOfRecords) {
+  TrainingData training_data = TrainingDataFromTestInfo();
+  for (int i = 0; i < 30; ++i) {
+    std::vector<mojom::CovariateInfoPtr> covariates;
+    for (const auto& covariate : training_data[0]) {
+      covariates.push_back(covariate.Clone());
+    }
+    EXPECT_TRUE(AddTrainingInstance(std::move(covariates)));
+  }
+  EXPECT_EQ(60, RecordCount());
+
+  data_store_->PurgeTrainingDataAfterExpirationDate();
+
+  // Only the newest 50 records are kept.
+  EXPECT_EQ(50, RecordCount());
+  TrainingColumns columns = data_store_->LoadTrainingColumns();
+  ASSERT_EQ(50u, columns.training_instance_ids.size());
+  EXPECT_EQ(6, columns.training_instance_ids.front());
+  EXPECT_EQ(30, columns.training_instance_ids.back());
+}
+
 }  // namespace brave_federated
@@ -49,8 +49,10 @@ P3ABandwidthSavingsTracker::P3ABandwidthSavingsTracker(
 
 void P3ABandwidthSavingsTracker::RecordSavings(uint64_t savings) {
   if (savings > 0 && user_prefs_) {
-    // TODO(AndriusA): optimise if needed, loading permanent state on every
-    // record could be costly
+    // Not a deferred-save storage: there is a tracker per tab, all updating
+    // the same pref, so each one holding its own copy for a while would let
+    // tabs overwrite each other's savings. Loading the pref on every record
+    // keeps them consistent, at one write per page load with savings.
     WeeklyStorage weekly(user_prefs_, prefs::kBandwidthSavedDailyBytes);
     weekly.AddDelta(savings);
     StoreSavingsHistogram(weekly.GetWeeklySum());
@@ -8,7 +8,10 @@
 #include <array>
 
 #include "base/ranges/algorithm.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "brave/components/ipfs/buildflags/buildflags.h"
+#include "build/build_config.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
 #if BUILDFLAG(ENABLE_IPFS)
@@ -32,6 +35,22 @@ bool IsMediaPlatformURL(const GURL& url) {
   });
 }
 
+#if BUILDFLAG(IS_ANDROID)
+// These mirror the GetLinkType() checks in the ledger's legacy/media handlers
+// and must be kept in sync with them. The YouTube, Vimeo and GitHub handlers
+// look for them anywhere in the URL, not just in its host and path.
+constexpr const char* kMediaLoadSubstrings[] = {
+    "https://m.youtube.com/api/stats/watchtime?",
+    "https://www.youtube.com/api/stats/watchtime?",
+    "https://fresnel.vimeocdn.com/add/player-stats?",
+    "github.com",
+};
+// The Twitch handler matches the domain, including subdomains, and a path
+// prefix.
+constexpr char kTwitchSegmentDomain[] = "ttvnw.net";
+constexpr char kTwitchSegmentPath[] = "/v1/segment/";
+#endif
+
 }  // namespace
 
 absl::optional<std::string> GetPublisherIdFromURL(const GURL& url) {
@@ -62,4 +81,23 @@ absl::optional<std::string> GetPublisherIdFromURL(const GURL& url) {
   return domain;
 }
 
+bool IsMediaActivityLoad(const GURL& url) {
+#if BUILDFLAG(IS_ANDROID)
+  if (!url.is_valid()) {
+    return false;
+  }
+
+  if (url.DomainIs(kTwitchSegmentDomain) &&
+      base::StartsWith(url.path_piece(), kTwitchSegmentPath)) {
+    return true;
+  }
+  const std::string& spec = url.spec();
+  return base::ranges::any_of(kMediaLoadSubstrings, [&](const char* match) {
+    return spec.find(match) != std::string::npos;
+  });
+#else
+  return false;
+#endif
+}
+
 }  // namespace brave_rewards
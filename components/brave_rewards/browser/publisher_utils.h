@@ -19,6 +19,13 @@ namespace brave_rewards {
 // platform where multiple publishers can be registered.
 absl::optional<std::string> GetPublisherIdFromURL(const GURL& url);
 
+// Returns true if a resource load of `url` may be turned into media activity
+// by the ledger's legacy media handlers (YouTube, Twitch, Vimeo and GitHub).
+// The ledger ignores every other load, so those don't need to be sent to it.
+// On desktop, media activity is reported by Greaselion scripts instead and
+// this always returns false.
+bool IsMediaActivityLoad(const GURL& url);
+
 }  // namespace brave_rewards
 
 #endif  // BRAVE_COMPONENTS_BRAVE_REWARDS_BROWSER_PUBLISHER_UTILS_H_
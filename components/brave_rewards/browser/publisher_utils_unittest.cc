@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
 
@@ -39,4 +40,35 @@ TEST_F(RewardsPublisherUtilsTest, GetPublisherIdFromURL) {
   EXPECT_EQ(GetPublisherId("https://twitch.tv/foo"), absl::nullopt);
 }
 
+TEST_F(RewardsPublisherUtilsTest, IsMediaActivityLoad) {
+  const char* const kMediaLoads[] = {
+      "https://www.youtube.com/api/stats/watchtime?docid=abc&st=1&et=2",
+      "https://m.youtube.com/api/stats/watchtime?docid=abc",
+      "https://video-edge-1.abc.ttvnw.net/v1/segment/abc.ts",
+      "https://fresnel.vimeocdn.com/add/player-stats?beacon=1",
+      "https://github.com/brave/brave-core",
+      "https://api.github.com/users/brave",
+      // The handlers match these anywhere in the URL.
+      "https://example.com/?ref=github.com",
+      "https://example.com/?u=https://www.youtube.com/api/stats/watchtime?a",
+  };
+  for (const char* url : kMediaLoads) {
+#if BUILDFLAG(IS_ANDROID)
+    EXPECT_TRUE(IsMediaActivityLoad(GURL(url))) << url;
+#else
+    EXPECT_FALSE(IsMediaActivityLoad(GURL(url))) << url;
+#endif
+  }
+
+  EXPECT_FALSE(IsMediaActivityLoad(GURL("https://brave.com/image.png")));
+  EXPECT_FALSE(
+      IsMediaActivityLoad(GURL("https://www.youtube.com/s/player/base.js")));
+  EXPECT_FALSE(IsMediaActivityLoad(GURL("https://i.ytimg.com/vi/abc/0.jpg")));
+  EXPECT_FALSE(
+      IsMediaActivityLoad(GURL("https://ttvnw.net.example.com/v1/segment/")));
+  EXPECT_FALSE(
+      IsMediaActivityLoad(GURL("https://www.youtube.com/api/stats/other?")));
+  EXPECT_FALSE(IsMediaActivityLoad(GURL("invalid-url")));
+}
+
 }  // namespace brave_rewards
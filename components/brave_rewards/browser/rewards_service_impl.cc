@@ -36,6 +36,7 @@
 #include "base/task/thread_pool.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "bat/ledger/global_constants.h"
 #include "bat/ledger/public/ledger_database.h"
 #include "brave/browser/ui/webui/brave_rewards_source.h"
@@ -43,6 +44,7 @@
 #include "brave/components/brave_rewards/browser/android_util.h"
 #include "brave/components/brave_rewards/browser/diagnostic_log.h"
 #include "brave/components/brave_rewards/browser/logging.h"
+#include "brave/components/brave_rewards/browser/publisher_utils.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service.h"
 #include "brave/components/brave_rewards/browser/rewards_notification_service_impl.h"
 #include "brave/components/brave_rewards/browser/rewards_p3a.h"
@@ -103,6 +105,10 @@ constexpr int kDiagnosticLogKeepNumLines = 20000;
 constexpr int kDiagnosticLogMaxFileSize = 10 * (1024 * 1024);
 constexpr char pref_prefix[] = "brave.rewards";
 
+// How long media loads are collected before being sent to the ledger as one
+// batch.
+constexpr base::TimeDelta kMediaLoadBatchDelay = base::Seconds(1);
+
 std::string URLMethodToRequestType(ledger::mojom::UrlMethod method) {
   switch (method) {
     case ledger::mojom::UrlMethod::GET:
@@ -853,26 +859,53 @@ void RewardsServiceImpl::OnXHRLoad(SessionID tab_id,
     return;
   }
 
-  if (!ProcessPublisher(url)) {
+  if (!IsMediaActivityLoad(url) || !ProcessPublisher(url)) {
     return;
   }
 
-  base::flat_map<std::string, std::string> parts;
+  // Media players tend to repeat the same request; it only needs to be
+  // reported once per batch.
+  const bool is_duplicate =
+      base::ranges::any_of(pending_media_loads_, [&](const MediaLoad& load) {
+        return load.tab_id == tab_id && load.url == url &&
+               load.first_party_url == first_party_url &&
+               load.referrer == referrer;
+      });
+  if (is_duplicate) {
+    return;
+  }
 
-  for (net::QueryIterator it(url); !it.IsAtEnd(); it.Advance()) {
-    parts[std::string(it.GetKey())] = it.GetUnescapedValue();
+  pending_media_loads_.push_back({tab_id, url, first_party_url, referrer});
+  if (!media_load_timer_) {
+    media_load_timer_ = std::make_unique<base::OneShotTimer>();
   }
+  if (!media_load_timer_->IsRunning()) {
+    media_load_timer_->Start(FROM_HERE, kMediaLoadBatchDelay, this,
+                             &RewardsServiceImpl::FlushMediaLoads);
+  }
+}
 
-  ledger::mojom::VisitDataPtr data = ledger::mojom::VisitData::New();
-  data->path = url.spec();
-  data->tab_id = tab_id.id();
+void RewardsServiceImpl::FlushMediaLoads() {
+  std::vector<MediaLoad> loads;
+  loads.swap(pending_media_loads_);
+  if (!Connected()) {
+    return;
+  }
+
+  for (const auto& load : loads) {
+    base::flat_map<std::string, std::string> parts;
+    for (net::QueryIterator it(load.url); !it.IsAtEnd(); it.Advance()) {
+      parts[std::string(it.GetKey())] = it.GetUnescapedValue();
+    }
 
-  bat_ledger_->OnXHRLoad(tab_id.id(),
-                         url.spec(),
-                         parts,
-                         first_party_url.spec(),
-                         referrer.spec(),
-                         std::move(data));
+    ledger::mojom::VisitDataPtr data = ledger::mojom::VisitData::New();
+    data->path = load.url.spec();
+    data->tab_id = load.tab_id.id();
+
+    bat_ledger_->OnXHRLoad(load.tab_id.id(), load.url.spec(), parts,
+                           load.first_party_url.spec(), load.referrer.spec(),
+                           std::move(data));
+  }
 }
 
 void RewardsServiceImpl::OnRestorePublishers(
@@ -918,6 +951,12 @@ void RewardsServiceImpl::Shutdown() {
 
   url_loaders_.clear();
 
+  // Don't lose the media loads still waiting for their batch.
+  if (media_load_timer_) {
+    media_load_timer_->Stop();
+  }
+  FlushMediaLoads();
+
   bat_ledger_.reset();
   RewardsService::Shutdown();
 }
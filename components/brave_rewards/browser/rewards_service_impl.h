@@ -393,6 +393,9 @@ class RewardsServiceImpl : public RewardsService,
   void StopNotificationTimers();
   void OnNotificationTimerFired();
 
+  // Sends the media loads collected since the last batch to the ledger.
+  void FlushMediaLoads();
+
   void MaybeShowNotificationAddFunds();
   bool ShouldShowNotificationAddFunds() const;
   void ShowNotificationAddFunds(bool sufficient);
@@ -632,6 +635,16 @@ class RewardsServiceImpl : public RewardsService,
       current_media_fetchers_;
   std::unique_ptr<base::OneShotTimer> notification_startup_timer_;
   std::unique_ptr<base::RepeatingTimer> notification_periodic_timer_;
+
+  // Loads that passed IsMediaActivityLoad() and wait for FlushMediaLoads().
+  struct MediaLoad {
+    SessionID tab_id;
+    GURL url;
+    GURL first_party_url;
+    GURL referrer;
+  };
+  std::vector<MediaLoad> pending_media_loads_;
+  std::unique_ptr<base::OneShotTimer> media_load_timer_;
   PrefChangeRegistrar profile_pref_change_registrar_;
 
   uint32_t next_timer_id_;
@@ -78,7 +78,8 @@ BraveNewsController::BraveNewsController(
     favicon::FaviconService* favicon_service,
     brave_ads::AdsService* ads_service,
     history::HistoryService* history_service,
-    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory)
+    scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory,
+    const base::FilePath& feed_cache_directory)
     : prefs_(prefs),
       favicon_service_(favicon_service),
       ads_service_(ads_service),
@@ -99,7 +100,8 @@ BraveNewsController::BraveNewsController(
                        &channels_controller_,
                        history_service,
                        &api_request_helper_,
-                       prefs_),
+                       prefs_,
+                       feed_cache_directory),
       suggestions_controller_(prefs_,
                               &publishers_controller_,
                               &api_request_helper_,
@@ -309,7 +309,14 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
                PrefService* prefs) {
   Channels channels =
       ChannelsController::GetChannelsFromPublishers(*publishers, prefs);
+  return BuildFeed(feed_items, history_hosts, publishers, feed, channels);
+}
 
+bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
+               const std::unordered_set<std::string>& history_hosts,
+               Publishers* publishers,
+               mojom::Feed* feed,
+               const Channels& channels) {
   std::list<mojom::ArticlePtr> articles;
   std::list<mojom::PromotedArticlePtr> promoted_articles;
   std::list<mojom::DealPtr> deals;
@@ -25,6 +25,14 @@ bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
                mojom::Feed* feed,
                PrefService* prefs);
 
+// Same as above, but with |channels| already resolved from prefs so that it
+// does not need to touch the PrefService and can run on any sequence.
+bool BuildFeed(const std::vector<mojom::FeedItemPtr>& feed_items,
+               const std::unordered_set<std::string>& history_hosts,
+               Publishers* publishers,
+               mojom::Feed* feed,
+               const Channels& channels);
+
 // Exposed for testing
 bool ShouldDisplayFeedItem(const mojom::FeedItemPtr& feed_item,
                            const Publishers* publishers,
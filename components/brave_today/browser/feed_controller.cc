@@ -10,7 +10,6 @@
 #include <iterator>
 #include <memory>
 #include <string>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -18,23 +17,28 @@
 #include "base/bind.h"
 #include "base/callback_forward.h"
 #include "base/feature_list.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
 #include "base/logging.h"
 #include "base/one_shot_event.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_util.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_private_cdn/headers.h"
 #include "brave/components/brave_today/browser/channels_controller.h"
 #include "brave/components/brave_today/browser/direct_feed_controller.h"
 #include "brave/components/brave_today/browser/feed_building.h"
 #include "brave/components/brave_today/browser/feed_parsing.h"
+#include "brave/components/brave_today/browser/history_hosts_summary.h"
 #include "brave/components/brave_today/browser/locales_helper.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/browser/urls.h"
 #include "brave/components/brave_today/common/brave_news.mojom-shared.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
 #include "brave/components/brave_today/common/features.h"
-#include "components/history/core/browser/history_service.h"
-#include "components/history/core/browser/history_types.h"
 #include "components/prefs/pref_service.h"
 
 namespace brave_news {
@@ -53,6 +57,91 @@ GURL GetFeedUrl(const std::string& default_locale) {
   return feed_url;
 }
 
+// Returns the file that caches the feed for |locale|, named after the remote
+// file so that v1 and v2 feeds don't collide. Returns an empty path if the
+// name isn't safe to use as a file name.
+base::FilePath GetCacheFilePath(const base::FilePath& cache_directory,
+                                const std::string& locale) {
+  const std::string file_name = GetFeedUrl(locale).ExtractFileName();
+  if (file_name.empty() || file_name[0] == '.' ||
+      !base::ranges::all_of(file_name, [](char c) {
+        return base::IsAsciiAlphaNumeric(c) || c == '.' || c == '_' ||
+               c == '-';
+      })) {
+    return base::FilePath();
+  }
+  return cache_directory.AppendASCII(file_name);
+}
+
+// Cache files hold the etag on the first line followed by the raw feed body.
+absl::optional<std::string> ReadCachedFeed(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents)) {
+    return absl::nullopt;
+  }
+  return contents;
+}
+
+void WriteCachedFeed(const base::FilePath& path, const std::string& contents) {
+  if (!base::CreateDirectory(path.DirName())) {
+    VLOG(1) << "Could not create Brave News cache directory";
+    return;
+  }
+  if (!base::ImportantFileWriter::WriteFileAtomically(path, contents)) {
+    VLOG(1) << "Could not write Brave News feed cache " << path;
+  }
+}
+
+FeedItems CloneFeedItems(const FeedItems& feed_items) {
+  FeedItems clone;
+  clone.reserve(feed_items.size());
+  for (const auto& item : feed_items) {
+    clone.push_back(item->Clone());
+  }
+  return clone;
+}
+
+// Decodes a single locale's feed on the thread pool. Every locale gets its
+// own task, so the feeds for multiple locales are decoded in parallel.
+void ParseFeedItemsOffMainThread(std::string json,
+                                 GetFeedItemsCallback callback) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(
+          [](std::string json) {
+            FeedItems feed_items;
+            ParseFeedItems(json, &feed_items);
+            return feed_items;
+          },
+          std::move(json)),
+      std::move(callback));
+}
+
+using BuildFeedCallback = base::OnceCallback<void(mojom::FeedPtr)>;
+void BuildFeedOffMainThread(
+    FeedItems feed_items,
+    scoped_refptr<const HistoryHostsSummary::Hosts> history_hosts,
+    Publishers publishers,
+    Channels channels,
+    BuildFeedCallback callback) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(
+          [](FeedItems feed_items,
+             scoped_refptr<const HistoryHostsSummary::Hosts> history_hosts,
+             Publishers publishers, Channels channels) {
+            auto feed = mojom::Feed::New();
+            if (!BuildFeed(feed_items, history_hosts->data, &publishers,
+                           feed.get(), channels)) {
+              VLOG(1) << "ParseFeed reported failure.";
+            }
+            return feed;
+          },
+          std::move(feed_items), std::move(history_hosts),
+          std::move(publishers), std::move(channels)),
+      std::move(callback));
+}
+
 }  // namespace
 
 FeedController::FeedController(
@@ -61,15 +150,20 @@ FeedController::FeedController(
     ChannelsController* channels_controller,
     history::HistoryService* history_service,
     api_request_helper::APIRequestHelper* api_request_helper,
-    PrefService* prefs)
+    PrefService* prefs,
+    const base::FilePath& cache_directory)
     : prefs_(prefs),
       publishers_controller_(publishers_controller),
       direct_feed_controller_(direct_feed_controller),
       channels_controller_(channels_controller),
-      history_service_(history_service),
+      history_hosts_summary_(history_service),
       api_request_helper_(api_request_helper),
       on_current_update_complete_(new base::OneShotEvent()),
-      publishers_observation_(this) {
+      publishers_observation_(this),
+      cache_directory_(cache_directory),
+      file_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {
   publishers_observation_.Observe(publishers_controller);
 }
 
@@ -160,34 +254,25 @@ void FeedController::EnsureFeedIsUpdating() {
               // Get history hosts via callback
               auto onHistory = base::BindOnce(
                   [](FeedController* controller, FeedItems all_feed_items,
-                     Publishers publishers, history::QueryResults results) {
-                    std::unordered_set<std::string> history_hosts;
-                    for (const auto& item : results) {
-                      auto host = item.url().host();
-                      history_hosts.insert(host);
-                    }
-                    VLOG(1) << "history hosts # " << history_hosts.size();
-                    // Parse directly to in-memory property
-                    controller->ResetFeed();
-                    std::vector<mojom::FeedItemPtr> feed_items;
-                    if (BuildFeed(all_feed_items, history_hosts, &publishers,
-                                  &controller->current_feed_,
-                                  controller->prefs_)) {
-                    } else {
-                      VLOG(1) << "ParseFeed reported failure.";
-                    }
-                    // Let any callbacks know that the data is ready
-                    // or errored.
-                    controller->NotifyUpdateDone();
+                     Publishers publishers,
+                     scoped_refptr<const HistoryHostsSummary::Hosts>
+                         history_hosts) {
+                    // Channels depend on prefs, so resolve them here and
+                    // do the scoring and page building on the thread pool.
+                    Channels channels =
+                        ChannelsController::GetChannelsFromPublishers(
+                            publishers, controller->prefs_);
+                    BuildFeedOffMainThread(
+                        std::move(all_feed_items), std::move(history_hosts),
+                        std::move(publishers), std::move(channels),
+                        base::BindOnce(&FeedController::OnFeedBuilt,
+                                       controller->weak_ptr_factory_
+                                           .GetWeakPtr()));
                   },
                   base::Unretained(controller), std::move(all_feed_items),
                   std::move(publishers));
-              history::QueryOptions options;
-              options.max_count = 2000;
-              options.SetRecentDayRange(14);
-              controller->history_service_->QueryHistory(
-                  std::u16string(), options, std::move(onHistory),
-                  &controller->task_tracker_);
+              controller->history_hosts_summary_.GetHosts(
+                  std::move(onHistory));
             },
             base::Unretained(controller), std::move(publishers));
         // Perform all feed downloads in parallel
@@ -230,8 +315,6 @@ void FeedController::UpdateIfRemoteChanged() {
                   if (base::ranges::any_of(updates, [](bool has_update) {
                         return has_update;
                       })) {
-                    // TODO(fallaciousreasoning): Only fetch the specific feed
-                    // which changes.
                     controller->EnsureFeedIsUpdating();
                   }
                 },
@@ -249,7 +332,8 @@ void FeedController::UpdateIfRemoteChanged() {
           controller->api_request_helper_->Request(
               "HEAD", GetFeedUrl(locale), "", "", true,
               base::BindOnce(
-                  [](std::string current_etag,
+                  [](FeedController* controller, std::string locale,
+                     std::string current_etag,
                      base::RepeatingCallback<void(bool)> has_update_callback,
                      api_request_helper::APIRequestResult api_request_result) {
                     std::string etag;
@@ -276,10 +360,13 @@ void FeedController::UpdateIfRemoteChanged() {
                       has_update_callback.Run(false);
                       return;
                     }
-                    // Needs update
+                    // Needs update. Only this locale has to be
+                    // refetched, the others are rebuilt from memory.
+                    controller->locale_feed_items_.erase(locale);
                     has_update_callback.Run(true);
                   },
-                  it->second, check_completed_callback),
+                  base::Unretained(controller), locale, it->second,
+                  check_completed_callback),
               brave::private_cdn_headers);
         }
       },
@@ -288,6 +375,15 @@ void FeedController::UpdateIfRemoteChanged() {
 
 void FeedController::ClearCache() {
   ResetFeed();
+  locale_feed_items_.clear();
+  disk_cache_checked_locales_.clear();
+  // Otherwise the stale feed would be read back in when News is re-enabled.
+  // The directory only holds feed caches, and any later read or write is
+  // sequenced after the delete.
+  if (!cache_directory_.empty()) {
+    file_task_runner_->PostTask(
+        FROM_HERE, base::GetDeletePathRecursivelyCallback(cache_directory_));
+  }
 }
 
 void FeedController::OnPublishersUpdated(PublishersController* controller) {
@@ -325,46 +421,117 @@ void FeedController::FetchCombinedFeed(GetFeedItemsCallback callback) {
                 std::move(callback)));
 
         for (const auto& locale : locales) {
-          // Handle the response
-          auto response_handler = base::BindOnce(
-              [](FeedController* controller, std::string locale,
-                 GetFeedItemsCallback callback,
-                 api_request_helper::APIRequestResult api_request_result) {
-                std::string etag;
-                if (api_request_result.headers().contains(kEtagHeaderKey)) {
-                  etag = api_request_result.headers().at(kEtagHeaderKey);
-                }
-                VLOG(1) << "Downloaded feed, status: "
-                        << api_request_result.response_code()
-                        << " etag: " << etag;
-                // Handle bad response
-                if (api_request_result.response_code() != 200 ||
-                    api_request_result.body().empty()) {
-                  LOG(ERROR)
-                      << "Bad response from brave news feed.json. Status: "
-                      << api_request_result.response_code();
-                  std::move(callback).Run({});
-                  return;
-                }
-                // Only mark cache time of remote request if
-                // parsing was successful
-                controller->locale_feed_etags_[locale] = etag;
-                FeedItems feed_items;
-                ParseFeedItems(api_request_result.body(), &feed_items);
-                std::move(callback).Run(std::move(feed_items));
-              },
-              base::Unretained(controller), locale, locales_fetched_callback);
-          // Send the request
-          GURL feed_url(GetFeedUrl(locale));
-          VLOG(1) << "Making feed request to " << feed_url.spec();
-          controller->api_request_helper_->Request(
-              "GET", feed_url, "", "", true, std::move(response_handler),
-              brave::private_cdn_headers);
+          controller->GetOrFetchLocaleFeed(locale, locales_fetched_callback);
         }
       },
       base::Unretained(this), std::move(callback)));
 }
 
+void FeedController::GetOrFetchLocaleFeed(const std::string& locale,
+                                          GetFeedItemsCallback callback) {
+  auto it = locale_feed_items_.find(locale);
+  if (it != locale_feed_items_.end()) {
+    VLOG(1) << "Using in-memory feed items for " << locale;
+    std::move(callback).Run(CloneFeedItems(it->second));
+    return;
+  }
+  const base::FilePath cache_path =
+      cache_directory_.empty() ? base::FilePath()
+                               : GetCacheFilePath(cache_directory_, locale);
+  if (!cache_path.empty() && !disk_cache_checked_locales_.contains(locale)) {
+    disk_cache_checked_locales_.insert(locale);
+    file_task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE, base::BindOnce(&ReadCachedFeed, cache_path),
+        base::BindOnce(&FeedController::OnCachedLocaleFeedRead,
+                       weak_ptr_factory_.GetWeakPtr(), locale,
+                       std::move(callback)));
+    return;
+  }
+  FetchLocaleFeed(locale, std::move(callback));
+}
+
+void FeedController::FetchLocaleFeed(const std::string& locale,
+                                     GetFeedItemsCallback callback) {
+  // Send the request
+  GURL feed_url(GetFeedUrl(locale));
+  VLOG(1) << "Making feed request to " << feed_url.spec();
+  api_request_helper_->Request(
+      "GET", feed_url, "", "", true,
+      base::BindOnce(&FeedController::OnLocaleFeedFetched,
+                     base::Unretained(this), locale, std::move(callback)),
+      brave::private_cdn_headers);
+}
+
+void FeedController::OnLocaleFeedFetched(
+    const std::string& locale,
+    GetFeedItemsCallback callback,
+    api_request_helper::APIRequestResult api_request_result) {
+  std::string etag;
+  if (api_request_result.headers().contains(kEtagHeaderKey)) {
+    etag = api_request_result.headers().at(kEtagHeaderKey);
+  }
+  VLOG(1) << "Downloaded feed, status: " << api_request_result.response_code()
+          << " etag: " << etag;
+  // Handle bad response
+  if (api_request_result.response_code() != 200 ||
+      api_request_result.body().empty()) {
+    LOG(ERROR) << "Bad response from brave news feed.json. Status: "
+               << api_request_result.response_code();
+    std::move(callback).Run({});
+    return;
+  }
+  // Only mark cache time of remote request if
+  // parsing was successful
+  locale_feed_etags_[locale] = etag;
+  const base::FilePath cache_path =
+      cache_directory_.empty() ? base::FilePath()
+                               : GetCacheFilePath(cache_directory_, locale);
+  if (!cache_path.empty() && !etag.empty() &&
+      etag.find('\n') == std::string::npos) {
+    file_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&WriteCachedFeed, cache_path,
+                       base::StrCat({etag, "\n", api_request_result.body()})));
+  }
+  ParseFeedItemsOffMainThread(
+      api_request_result.body(),
+      base::BindOnce(&FeedController::OnLocaleFeedParsed,
+                     weak_ptr_factory_.GetWeakPtr(), locale,
+                     std::move(callback)));
+}
+
+void FeedController::OnCachedLocaleFeedRead(
+    const std::string& locale,
+    GetFeedItemsCallback callback,
+    absl::optional<std::string> contents) {
+  const size_t newline =
+      contents ? contents->find('\n') : std::string::npos;
+  if (newline == std::string::npos || newline == 0) {
+    VLOG(1) << "No usable feed cache for " << locale;
+    FetchLocaleFeed(locale, std::move(callback));
+    return;
+  }
+  VLOG(1) << "Using cached feed for " << locale;
+  // Remember the etag so that the remote check after rendering only refetches
+  // this locale if it actually changed.
+  locale_feed_etags_[locale] = contents->substr(0, newline);
+  contents->erase(0, newline + 1);
+  should_check_remote_after_update_ = true;
+  ParseFeedItemsOffMainThread(
+      std::move(*contents),
+      base::BindOnce(&FeedController::OnLocaleFeedParsed,
+                     weak_ptr_factory_.GetWeakPtr(), locale,
+                     std::move(callback)));
+}
+
+void FeedController::OnLocaleFeedParsed(const std::string& locale,
+                                        GetFeedItemsCallback callback,
+                                        FeedItems feed_items) {
+  // BuildFeed consumes the items it is given, so keep our own copy.
+  locale_feed_items_[locale] = CloneFeedItems(feed_items);
+  std::move(callback).Run(std::move(feed_items));
+}
+
 void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
   VLOG(1) << "getorfetch feed(oc) start: "
           << on_current_update_complete_->is_signaled();
@@ -381,6 +548,20 @@ void FeedController::GetOrFetchFeed(base::OnceClosure callback) {
   EnsureFeedIsUpdating();
 }
 
+void FeedController::OnFeedBuilt(mojom::FeedPtr feed) {
+  current_feed_.hash = std::move(feed->hash);
+  current_feed_.pages = std::move(feed->pages);
+  current_feed_.featured_item = std::move(feed->featured_item);
+  // Let any callbacks know that the data is ready or errored.
+  NotifyUpdateDone();
+  // A feed built from the disk cache is shown straight away, but may be
+  // stale, so see whether the remote has anything newer.
+  if (should_check_remote_after_update_) {
+    should_check_remote_after_update_ = false;
+    UpdateIfRemoteChanged();
+  }
+}
+
 void FeedController::ResetFeed() {
   current_feed_.featured_item = nullptr;
   current_feed_.hash = "";
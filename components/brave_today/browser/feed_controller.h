@@ -11,16 +11,25 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/containers/flat_set.h"
+#include "base/files/file_path.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/one_shot_event.h"
 #include "base/scoped_observation.h"
 #include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/brave_today/browser/channels_controller.h"
 #include "brave/components/brave_today/browser/direct_feed_controller.h"
+#include "brave/components/brave_today/browser/history_hosts_summary.h"
 #include "brave/components/brave_today/browser/publishers_controller.h"
 #include "brave/components/brave_today/common/brave_news.mojom.h"
-#include "components/history/core/browser/history_service.h"
 #include "components/prefs/pref_service.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
 
 namespace history {
 class HistoryService;
@@ -39,7 +48,8 @@ class FeedController : public PublishersController::Observer {
                  ChannelsController* channels_controller,
                  history::HistoryService* history_service,
                  api_request_helper::APIRequestHelper* api_request_helper,
-                 PrefService* prefs);
+                 PrefService* prefs,
+                 const base::FilePath& cache_directory);
   ~FeedController() override;
   FeedController(const FeedController&) = delete;
   FeedController& operator=(const FeedController&) = delete;
@@ -70,7 +80,23 @@ class FeedController : public PublishersController::Observer {
 
  private:
   void FetchCombinedFeed(GetFeedItemsCallback callback);
+  // Provides the items for a single locale, preferring the in-memory copy,
+  // then the on-disk cache and only then the network.
+  void GetOrFetchLocaleFeed(const std::string& locale,
+                            GetFeedItemsCallback callback);
+  void FetchLocaleFeed(const std::string& locale,
+                       GetFeedItemsCallback callback);
+  void OnLocaleFeedFetched(const std::string& locale,
+                           GetFeedItemsCallback callback,
+                           api_request_helper::APIRequestResult result);
+  void OnCachedLocaleFeedRead(const std::string& locale,
+                              GetFeedItemsCallback callback,
+                              absl::optional<std::string> contents);
+  void OnLocaleFeedParsed(const std::string& locale,
+                          GetFeedItemsCallback callback,
+                          FeedItems feed_items);
   void GetOrFetchFeed(base::OnceClosure callback);
+  void OnFeedBuilt(mojom::FeedPtr feed);
   void ResetFeed();
   void NotifyUpdateDone();
 
@@ -78,11 +104,10 @@ class FeedController : public PublishersController::Observer {
   raw_ptr<PublishersController> publishers_controller_ = nullptr;
   raw_ptr<DirectFeedController> direct_feed_controller_ = nullptr;
   raw_ptr<ChannelsController> channels_controller_ = nullptr;
-  raw_ptr<history::HistoryService> history_service_ = nullptr;
+  // Hosts from browsing history, used to score articles.
+  HistoryHostsSummary history_hosts_summary_;
   raw_ptr<api_request_helper::APIRequestHelper> api_request_helper_ = nullptr;
 
-  // The task tracker for the HistoryService callbacks.
-  base::CancelableTaskTracker task_tracker_;
   // Internal callers subscribe to this to know when the current in-progress
   // fetch and parse is complete.
   std::unique_ptr<base::OneShotEvent> on_current_update_complete_;
@@ -95,7 +120,23 @@ class FeedController : public PublishersController::Observer {
   // A map from feed locale to the last known etag for that feed. Used to
   // determine when we have available updates.
   base::flat_map<std::string, std::string> locale_feed_etags_;
+  // Parsed items for every locale fetched so far. Updates only refetch the
+  // locales whose etag changed and rebuild from this for the rest.
+  base::flat_map<std::string, FeedItems> locale_feed_items_;
   bool is_update_in_progress_ = false;
+
+  // Where the raw feed for each locale is persisted, so that the first feed
+  // after a restart can be built without waiting on the network. Empty if
+  // the disk cache is disabled.
+  base::FilePath cache_directory_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  // Locales for which the disk cache has already been consulted.
+  base::flat_set<std::string> disk_cache_checked_locales_;
+  // Set when the feed being built used disk-cached data, which should be
+  // checked against the remote once it has been rendered.
+  bool should_check_remote_after_update_ = false;
+
+  base::WeakPtrFactory<FeedController> weak_ptr_factory_{this};
 };
 
 }  // namespace brave_news
@@ -0,0 +1,359 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/feed_controller.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
+#include "brave/components/api_request_helper/api_request_helper.h"
+#include "brave/components/brave_today/browser/channels_controller.h"
+#include "brave/components/brave_today/browser/direct_feed_controller.h"
+#include "brave/components/brave_today/browser/feed_building.h"
+#include "brave/components/brave_today/browser/feed_parsing.h"
+#include "brave/components/brave_today/browser/publishers_controller.h"
+#include "brave/components/brave_today/browser/unsupported_publisher_migrator.h"
+#include "brave/components/brave_today/browser/urls.h"
+#include "brave/components/brave_today/common/brave_news.mojom.h"
+#include "brave/components/brave_today/common/features.h"
+#include "chrome/test/base/testing_profile.h"
+#include "content/public/test/browser_task_environment.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/test/test_url_loader_factory.h"
+#include "services/network/test/test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+namespace {
+
+constexpr char kPublishersResponse[] = R"([
+    {
+        "publisher_id": "111",
+        "publisher_name": "Test Publisher 1",
+        "feed_url": "https://tp1.example.com/feed",
+        "site_url": "https://tp1.example.com",
+        "category": "Top News",
+        "enabled": true
+    },
+    {
+        "publisher_id": "222",
+        "publisher_name": "Test Publisher 2",
+        "feed_url": "https://tp2.example.com/feed",
+        "site_url": "https://tp2.example.com",
+        "category": "Technology",
+        "enabled": true
+    }
+])";
+
+constexpr char kFeedResponse[] = R"([
+    {
+      "category": "Top News",
+      "publish_time": "2021-09-01 07:00:58",
+      "url": "https://tp1.example.com/featured/",
+      "title": "Featured article",
+      "description": "The article which should be featured.",
+      "content_type": "article",
+      "publisher_id": "111",
+      "publisher_name": "Test Publisher 1",
+      "creative_instance_id": "",
+      "url_hash": "9aaa370ed4c2888bc6603404dcc44ed1125d3347101873798d2ec8a0a9c424b1",
+      "padded_img": "https://pcdn.brave.com/brave-today/cache/1.jpg.pad",
+      "score": 13.96799592432192
+    },
+    {
+      "category": "Technology",
+      "publish_time": "2021-09-01 07:01:28",
+      "url": "https://tp2.example.com/first/",
+      "title": "First article",
+      "description": "The first technology article.",
+      "content_type": "article",
+      "publisher_id": "222",
+      "publisher_name": "Test Publisher 2",
+      "creative_instance_id": "",
+      "url_hash": "523b9f2091474c2a082c06ec17965f8c2392f871917407228bbeb51d8a55d6be",
+      "padded_img": "https://pcdn.brave.com/brave-today/cache/2.jpg.pad",
+      "score": 13.93160989810695
+    },
+    {
+      "category": "Technology",
+      "publish_time": "2021-09-01 07:04:32",
+      "url": "https://tp2.example.com/second/",
+      "title": "Second article",
+      "description": "The second technology article.",
+      "content_type": "article",
+      "publisher_id": "222",
+      "publisher_name": "Test Publisher 2",
+      "creative_instance_id": "",
+      "url_hash": "7bb5d8b3e2eee9d317f0568dcb094850fdf2862b2ed6d583c62b2245ea507ab8",
+      "padded_img": "https://pcdn.brave.com/brave-today/cache/3.jpg.pad",
+      "score": 14.525910905005045
+    }
+])";
+
+}  // namespace
+
+class FeedControllerTest : public testing::Test {
+ public:
+  FeedControllerTest()
+      : FeedControllerTest(
+            base::test::TaskEnvironment::ThreadPoolExecutionMode::ASYNC) {}
+
+ protected:
+  explicit FeedControllerTest(
+      base::test::TaskEnvironment::ThreadPoolExecutionMode thread_pool_mode)
+      : browser_task_environment_(thread_pool_mode),
+        api_request_helper_(TRAFFIC_ANNOTATION_FOR_TESTS,
+                            test_url_loader_factory_.GetSafeWeakWrapper()),
+        direct_feed_controller_(profile_.GetPrefs(), nullptr),
+        unsupported_publishers_migrator_(profile_.GetPrefs(),
+                                         &direct_feed_controller_,
+                                         &api_request_helper_),
+        publishers_controller_(profile_.GetPrefs(),
+                               &direct_feed_controller_,
+                               &unsupported_publishers_migrator_,
+                               &api_request_helper_),
+        channels_controller_(profile_.GetPrefs(), &publishers_controller_) {
+    // The v1 feed has a single locale, which keeps the urls simple.
+    scoped_features_.InitAndDisableFeature(
+        brave_today::features::kBraveNewsV2Feature);
+    test_url_loader_factory_.AddResponse(GetSourcesUrl(), kPublishersResponse,
+                                         net::HTTP_OK);
+  }
+
+  void CreateFeedController(const base::FilePath& cache_directory) {
+    feed_controller_ = std::make_unique<FeedController>(
+        &publishers_controller_, &direct_feed_controller_,
+        &channels_controller_, nullptr, &api_request_helper_,
+        profile_.GetPrefs(), cache_directory);
+  }
+
+  std::string GetSourcesUrl() {
+    return "https://" + brave_today::GetHostname() + "/sources." +
+           brave_today::GetRegionUrlPart() + "json";
+  }
+
+  std::string GetFeedUrl() {
+    return "https://" + brave_today::GetHostname() + "/brave-today/feed." +
+           brave_today::GetV1RegionUrlPart() + "json";
+  }
+
+  mojom::FeedPtr GetFeed() {
+    base::RunLoop loop;
+    mojom::FeedPtr feed;
+    feed_controller_->GetOrFetchFeed(
+        base::BindLambdaForTesting([&feed, &loop](mojom::FeedPtr result) {
+          feed = std::move(result);
+          loop.Quit();
+        }));
+    loop.Run();
+    return feed;
+  }
+
+  // Serves the feed with |etag|, for both GET and HEAD requests.
+  void AddFeedResponse(const std::string& etag) {
+    auto head = network::CreateURLResponseHead(net::HTTP_OK);
+    head->headers->AddHeader("etag", etag);
+    test_url_loader_factory_.AddResponse(
+        GURL(GetFeedUrl()), std::move(head), kFeedResponse,
+        network::URLLoaderCompletionStatus(net::OK));
+  }
+
+  base::FilePath GetCacheFilePath() {
+    return temp_dir_.GetPath().AppendASCII("feed." +
+                                           brave_today::GetV1RegionUrlPart() +
+                                           "json");
+  }
+
+  // Counts the requests made for the feed, by method.
+  void CountFeedRequests() {
+    test_url_loader_factory_.SetInterceptor(
+        base::BindLambdaForTesting([this](const network::ResourceRequest& r) {
+          if (r.url.spec() == GetFeedUrl()) {
+            feed_requests_[r.method]++;
+          }
+        }));
+  }
+
+  Publishers GetPublishers() {
+    base::RunLoop loop;
+    Publishers publishers;
+    publishers_controller_.GetOrFetchPublishers(
+        base::BindLambdaForTesting([&publishers, &loop](Publishers result) {
+          publishers = std::move(result);
+          loop.Quit();
+        }));
+    loop.Run();
+    return publishers;
+  }
+
+  base::test::ScopedFeatureList scoped_features_;
+  content::BrowserTaskEnvironment browser_task_environment_;
+  data_decoder::test::InProcessDataDecoder data_decoder_;
+  network::TestURLLoaderFactory test_url_loader_factory_;
+  api_request_helper::APIRequestHelper api_request_helper_;
+  TestingProfile profile_;
+  DirectFeedController direct_feed_controller_;
+  UnsupportedPublisherMigrator unsupported_publishers_migrator_;
+  PublishersController publishers_controller_;
+  ChannelsController channels_controller_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<FeedController> feed_controller_;
+  base::flat_map<std::string, int> feed_requests_;
+};
+
+// Holds thread pool tasks until the test explicitly runs them, so that the
+// controller can be observed while a parse is still in flight.
+class FeedControllerQueuedTest : public FeedControllerTest {
+ public:
+  FeedControllerQueuedTest()
+      : FeedControllerTest(
+            base::test::TaskEnvironment::ThreadPoolExecutionMode::QUEUED) {}
+};
+
+TEST_F(FeedControllerTest, FeedBuiltOffMainThreadMatchesSynchronousBuild) {
+  test_url_loader_factory_.AddResponse(GetFeedUrl(), kFeedResponse,
+                                       net::HTTP_OK);
+  CreateFeedController(base::FilePath());
+
+  auto feed = GetFeed();
+  ASSERT_TRUE(feed);
+  ASSERT_FALSE(feed->hash.empty());
+
+  // Build the same feed synchronously, the way it was built before parsing
+  // and building moved to the thread pool.
+  auto publishers = GetPublishers();
+  std::vector<mojom::FeedItemPtr> feed_items;
+  ASSERT_TRUE(ParseFeedItems(kFeedResponse, &feed_items));
+  mojom::Feed expected;
+  ASSERT_TRUE(BuildFeed(feed_items, {}, &publishers, &expected,
+                        profile_.GetPrefs()));
+
+  EXPECT_EQ(expected.hash, feed->hash);
+  ASSERT_EQ(expected.pages.size(), feed->pages.size());
+  for (size_t i = 0; i < expected.pages.size(); ++i) {
+    EXPECT_EQ(expected.pages[i]->items.size(), feed->pages[i]->items.size());
+  }
+  ASSERT_TRUE(expected.featured_item);
+  ASSERT_TRUE(feed->featured_item);
+  EXPECT_EQ(expected.featured_item->get_article()->data->url,
+            feed->featured_item->get_article()->data->url);
+}
+
+TEST_F(FeedControllerQueuedTest, DestroyingControllerWhileParsingIsSafe) {
+  test_url_loader_factory_.AddResponse(GetFeedUrl(), kFeedResponse,
+                                       net::HTTP_OK);
+  CreateFeedController(base::FilePath());
+
+  bool feed_received = false;
+  feed_controller_->GetOrFetchFeed(base::BindLambdaForTesting(
+      [&feed_received](mojom::FeedPtr) { feed_received = true; }));
+
+  // Only run the main thread, so the feed is downloaded but its parse is
+  // left waiting on the thread pool.
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, test_url_loader_factory_.NumPending());
+  EXPECT_EQ(2u, test_url_loader_factory_.total_requests());
+  EXPECT_FALSE(feed_received);
+
+  feed_controller_.reset();
+  // The parse completes after the controller is gone and its reply must be
+  // dropped.
+  browser_task_environment_.RunUntilIdle();
+  EXPECT_FALSE(feed_received);
+}
+
+TEST_F(FeedControllerTest, FeedIsBuiltFromDiskCache) {
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  ASSERT_TRUE(base::WriteFile(GetCacheFilePath(),
+                              std::string("cached-etag\n") + kFeedResponse));
+  CountFeedRequests();
+  CreateFeedController(temp_dir_.GetPath());
+
+  // No feed response is registered, so this can only come from the cache.
+  auto feed = GetFeed();
+  ASSERT_TRUE(feed);
+  EXPECT_FALSE(feed->hash.empty());
+  EXPECT_EQ(0, feed_requests_["GET"]);
+}
+
+TEST_F(FeedControllerTest, CachedEtagAvoidsRefetchingUnchangedFeed) {
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  ASSERT_TRUE(base::WriteFile(GetCacheFilePath(),
+                              std::string("cached-etag\n") + kFeedResponse));
+  AddFeedResponse("cached-etag");
+  CountFeedRequests();
+  CreateFeedController(temp_dir_.GetPath());
+
+  auto feed = GetFeed();
+  ASSERT_TRUE(feed);
+  EXPECT_FALSE(feed->hash.empty());
+  // Let the remote check that follows a cached feed complete.
+  browser_task_environment_.RunUntilIdle();
+
+  // The remote etag matches the cached one, so only the HEAD is made.
+  EXPECT_EQ(1, feed_requests_["HEAD"]);
+  EXPECT_EQ(0, feed_requests_["GET"]);
+}
+
+TEST_F(FeedControllerTest, FetchedFeedIsAvailableAfterRestart) {
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  AddFeedResponse("remote-etag");
+  CreateFeedController(temp_dir_.GetPath());
+
+  auto fetched_feed = GetFeed();
+  ASSERT_TRUE(fetched_feed);
+  ASSERT_FALSE(fetched_feed->hash.empty());
+  // Wait for the cache to be written.
+  browser_task_environment_.RunUntilIdle();
+  ASSERT_TRUE(base::PathExists(GetCacheFilePath()));
+
+  // Restart without the network.
+  feed_controller_.reset();
+  test_url_loader_factory_.ClearResponses();
+  test_url_loader_factory_.AddResponse(GetSourcesUrl(), kPublishersResponse,
+                                       net::HTTP_OK);
+  CountFeedRequests();
+  CreateFeedController(temp_dir_.GetPath());
+
+  auto cached_feed = GetFeed();
+  ASSERT_TRUE(cached_feed);
+  EXPECT_EQ(fetched_feed->hash, cached_feed->hash);
+  EXPECT_EQ(0, feed_requests_["GET"]);
+}
+
+TEST_F(FeedControllerTest, ClearCacheDeletesDiskCache) {
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  ASSERT_TRUE(base::WriteFile(GetCacheFilePath(),
+                              std::string("cached-etag\n") + kFeedResponse));
+  CreateFeedController(temp_dir_.GetPath());
+
+  feed_controller_->ClearCache();
+  browser_task_environment_.RunUntilIdle();
+  EXPECT_FALSE(base::PathExists(GetCacheFilePath()));
+
+  // Re-enabling must go to the network rather than the deleted cache.
+  AddFeedResponse("remote-etag");
+  CountFeedRequests();
+  auto feed = GetFeed();
+  ASSERT_TRUE(feed);
+  EXPECT_FALSE(feed->hash.empty());
+  EXPECT_EQ(1, feed_requests_["GET"]);
+}
+
+}  // namespace brave_news
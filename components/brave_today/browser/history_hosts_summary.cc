@@ -0,0 +1,133 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/history_hosts_summary.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+namespace {
+
+// Upper bound on the URLs read from history to seed the summary.
+constexpr int kMaxHistoryResults = 2000;
+
+}  // namespace
+
+HistoryHostsSummary::HistoryHostsSummary(
+    history::HistoryService* history_service)
+    : history_service_(history_service) {
+  if (history_service_) {
+    history_observation_.Observe(history_service_);
+  }
+}
+
+HistoryHostsSummary::~HistoryHostsSummary() = default;
+
+void HistoryHostsSummary::GetHosts(GetHostsCallback callback) {
+  if (!history_service_ || is_loaded_) {
+    std::move(callback).Run(GetSnapshot());
+    return;
+  }
+  pending_callbacks_.push_back(std::move(callback));
+  if (!is_loading_) {
+    QueryHistory();
+  }
+}
+
+void HistoryHostsSummary::OnURLVisited(
+    history::HistoryService* history_service,
+    const history::URLRow& url_row,
+    const history::VisitRow& new_visit) {
+  // Until history is first queried the visit will be part of the results.
+  if (!is_loading_ && !is_loaded_) {
+    return;
+  }
+  AddVisit(url_row.url(), new_visit.visit_time);
+}
+
+void HistoryHostsSummary::OnURLsDeleted(
+    history::HistoryService* history_service,
+    const history::DeletionInfo& deletion_info) {
+  // A host may still have other visits, so start over rather than trying to
+  // work out what is left.
+  task_tracker_.TryCancelAll();
+  last_visits_.clear();
+  snapshot_ = nullptr;
+  is_loading_ = false;
+  is_loaded_ = false;
+  if (!pending_callbacks_.empty()) {
+    QueryHistory();
+  }
+}
+
+void HistoryHostsSummary::QueryHistory() {
+  DCHECK(history_service_);
+  is_loading_ = true;
+  history::QueryOptions options;
+  options.max_count = kMaxHistoryResults;
+  options.SetRecentDayRange(kHistoryDays);
+  history_service_->QueryHistory(
+      std::u16string(), options,
+      base::BindOnce(&HistoryHostsSummary::OnHistoryQueried,
+                     base::Unretained(this)),
+      &task_tracker_);
+}
+
+void HistoryHostsSummary::OnHistoryQueried(history::QueryResults results) {
+  for (const auto& result : results) {
+    AddVisit(result.url(), result.visit_time());
+  }
+  is_loading_ = false;
+  is_loaded_ = true;
+
+  scoped_refptr<const Hosts> snapshot = GetSnapshot();
+  VLOG(1) << "history hosts # " << snapshot->data.size();
+  std::vector<GetHostsCallback> callbacks = std::move(pending_callbacks_);
+  for (auto& callback : callbacks) {
+    std::move(callback).Run(snapshot);
+  }
+}
+
+void HistoryHostsSummary::AddVisit(const GURL& url, base::Time visit_time) {
+  if (url.host_piece().empty()) {
+    return;
+  }
+  auto [it, inserted] = last_visits_.try_emplace(url.host(), visit_time);
+  if (inserted) {
+    snapshot_ = nullptr;
+  } else {
+    it->second = std::max(it->second, visit_time);
+  }
+}
+
+scoped_refptr<const HistoryHostsSummary::Hosts>
+HistoryHostsSummary::GetSnapshot() {
+  const base::Time cutoff = base::Time::Now() - base::Days(kHistoryDays);
+  if (snapshot_ && oldest_visit_ > cutoff) {
+    return snapshot_;
+  }
+
+  auto hosts = base::MakeRefCounted<Hosts>();
+  oldest_visit_ = base::Time::Max();
+  for (auto it = last_visits_.begin(); it != last_visits_.end();) {
+    if (it->second <= cutoff) {
+      it = last_visits_.erase(it);
+      continue;
+    }
+    hosts->data.insert(it->first);
+    oldest_visit_ = std::min(oldest_visit_, it->second);
+    ++it;
+  }
+  snapshot_ = std::move(hosts);
+  return snapshot_;
+}
+
+}  // namespace brave_news
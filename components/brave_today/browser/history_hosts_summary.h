@@ -0,0 +1,86 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_HISTORY_HOSTS_SUMMARY_H_
+#define BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_HISTORY_HOSTS_SUMMARY_H_
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/scoped_observation.h"
+#include "base/task/cancelable_task_tracker.h"
+#include "base/time/time.h"
+#include "components/history/core/browser/history_service.h"
+#include "components/history/core/browser/history_service_observer.h"
+#include "components/history/core/browser/history_types.h"
+
+class GURL;
+
+namespace brave_news {
+
+// Keeps track of the hosts visited in the last |kHistoryDays| days, which
+// the feed uses to boost articles from sites the user reads.
+//
+// History is queried once, the first time the hosts are requested, and kept
+// up to date from HistoryServiceObserver notifications afterwards, so feed
+// builds don't need to hit the history database. Deleting history drops
+// everything and the next request queries again.
+class HistoryHostsSummary : public history::HistoryServiceObserver {
+ public:
+  using Hosts = base::RefCountedData<std::unordered_set<std::string>>;
+  using GetHostsCallback =
+      base::OnceCallback<void(scoped_refptr<const Hosts>)>;
+
+  static constexpr int kHistoryDays = 14;
+
+  explicit HistoryHostsSummary(history::HistoryService* history_service);
+  ~HistoryHostsSummary() override;
+  HistoryHostsSummary(const HistoryHostsSummary&) = delete;
+  HistoryHostsSummary& operator=(const HistoryHostsSummary&) = delete;
+
+  // Provides an immutable snapshot of the visited hosts, which can be read
+  // from any thread. Snapshots are shared until the set of hosts changes.
+  void GetHosts(GetHostsCallback callback);
+
+  // history::HistoryServiceObserver:
+  void OnURLVisited(history::HistoryService* history_service,
+                    const history::URLRow& url_row,
+                    const history::VisitRow& new_visit) override;
+  void OnURLsDeleted(history::HistoryService* history_service,
+                     const history::DeletionInfo& deletion_info) override;
+
+ private:
+  void QueryHistory();
+  void OnHistoryQueried(history::QueryResults results);
+  void AddVisit(const GURL& url, base::Time visit_time);
+  scoped_refptr<const Hosts> GetSnapshot();
+
+  raw_ptr<history::HistoryService> history_service_ = nullptr;
+  bool is_loading_ = false;
+  bool is_loaded_ = false;
+  std::vector<GetHostsCallback> pending_callbacks_;
+
+  // Most recent visit to each host.
+  std::unordered_map<std::string, base::Time> last_visits_;
+  // Null whenever a host was added since it was built.
+  scoped_refptr<const Hosts> snapshot_;
+  // The least recent visit in |snapshot_|, after which it has to be rebuilt
+  // to drop hosts that fell out of the window.
+  base::Time oldest_visit_;
+
+  base::CancelableTaskTracker task_tracker_;
+  base::ScopedObservation<history::HistoryService,
+                          history::HistoryServiceObserver>
+      history_observation_{this};
+};
+
+}  // namespace brave_news
+
+#endif  // BRAVE_COMPONENTS_BRAVE_TODAY_BROWSER_HISTORY_HOSTS_SUMMARY_H_
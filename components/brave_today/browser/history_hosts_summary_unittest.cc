@@ -0,0 +1,112 @@
+// Copyright (c) 2022 The Brave Authors. All rights reserved.
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this file,
+// you can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "brave/components/brave_today/browser/history_hosts_summary.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "components/history/core/browser/history_service.h"
+#include "components/history/core/browser/history_types.h"
+#include "components/history/core/test/history_service_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave_news {
+
+class HistoryHostsSummaryTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    history_service_ =
+        history::CreateHistoryService(temp_dir_.GetPath(), true);
+    ASSERT_TRUE(history_service_);
+  }
+
+  void TearDown() override {
+    base::RunLoop run_loop;
+    history_service_->SetOnBackendDestroyTask(run_loop.QuitClosure());
+    history_service_.reset();
+    run_loop.Run();
+  }
+
+  scoped_refptr<const HistoryHostsSummary::Hosts> GetHosts(
+      HistoryHostsSummary* summary) {
+    base::RunLoop run_loop;
+    scoped_refptr<const HistoryHostsSummary::Hosts> result;
+    summary->GetHosts(base::BindLambdaForTesting(
+        [&](scoped_refptr<const HistoryHostsSummary::Hosts> hosts) {
+          result = std::move(hosts);
+          run_loop.Quit();
+        }));
+    run_loop.Run();
+    return result;
+  }
+
+  void AddVisit(const std::string& url, base::Time time) {
+    history_service_->AddPage(GURL(url), time, history::SOURCE_BROWSED);
+    history::BlockUntilHistoryProcessesPendingRequests(
+        history_service_.get());
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+  std::unique_ptr<history::HistoryService> history_service_;
+};
+
+TEST_F(HistoryHostsSummaryTest, ProvidesRecentlyVisitedHosts) {
+  AddVisit("https://www.espn.com/nba", base::Time::Now());
+  AddVisit("https://old.example.com/",
+           base::Time::Now() -
+               base::Days(HistoryHostsSummary::kHistoryDays + 1));
+
+  HistoryHostsSummary summary(history_service_.get());
+  auto hosts = GetHosts(&summary);
+  EXPECT_EQ(std::unordered_set<std::string>({"www.espn.com"}), hosts->data);
+
+  // Nothing changed, so the same snapshot is handed out again.
+  EXPECT_EQ(hosts, GetHosts(&summary));
+}
+
+TEST_F(HistoryHostsSummaryTest, FollowsNewVisits) {
+  HistoryHostsSummary summary(history_service_.get());
+  EXPECT_TRUE(GetHosts(&summary)->data.empty());
+
+  AddVisit("https://brave.com/", base::Time::Now());
+  auto hosts = GetHosts(&summary);
+  EXPECT_EQ(std::unordered_set<std::string>({"brave.com"}), hosts->data);
+
+  // Another visit to a known host doesn't need a new snapshot.
+  AddVisit("https://brave.com/download", base::Time::Now());
+  EXPECT_EQ(hosts, GetHosts(&summary));
+}
+
+TEST_F(HistoryHostsSummaryTest, ForgetsDeletedHistory) {
+  AddVisit("https://www.espn.com/nba", base::Time::Now());
+  AddVisit("https://brave.com/", base::Time::Now());
+
+  HistoryHostsSummary summary(history_service_.get());
+  EXPECT_EQ(2u, GetHosts(&summary)->data.size());
+
+  history_service_->DeleteURLs({GURL("https://www.espn.com/nba")});
+  history::BlockUntilHistoryProcessesPendingRequests(history_service_.get());
+  EXPECT_EQ(std::unordered_set<std::string>({"brave.com"}),
+            GetHosts(&summary)->data);
+}
+
+TEST_F(HistoryHostsSummaryTest, WorksWithoutHistoryService) {
+  HistoryHostsSummary summary(nullptr);
+  EXPECT_TRUE(GetHosts(&summary)->data.empty());
+}
+
+}  // namespace brave_news
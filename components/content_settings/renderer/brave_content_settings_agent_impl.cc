@@ -33,6 +33,10 @@
 namespace content_settings {
 namespace {
 
+// Bumped whenever the content setting rules shared by all frames of this
+// renderer change. Only accessed on the main thread.
+uint64_t g_content_setting_rules_generation = 0;
+
 bool IsFrameWithOpaqueOrigin(blink::WebFrame* frame) {
   // Storage access is keyed off the top origin and the frame's origin.
   // It will be denied any opaque origins so have this method to return early
@@ -87,6 +91,11 @@ BraveContentSettingsAgentImpl::BraveContentSettingsAgentImpl(
 
 BraveContentSettingsAgentImpl::~BraveContentSettingsAgentImpl() = default;
 
+// static
+void BraveContentSettingsAgentImpl::OnContentSettingRulesUpdated() {
+  ++g_content_setting_rules_generation;
+}
+
 bool BraveContentSettingsAgentImpl::IsScriptTemporilyAllowed(
     const GURL& script_url) {
   // Check if scripts from this origin are temporily allowed or not.
@@ -127,7 +136,7 @@ bool BraveContentSettingsAgentImpl::AllowScript(bool enabled_per_settings) {
   const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
 
   bool allow = ContentSettingsAgentImpl::AllowScript(enabled_per_settings);
-  allow = allow || IsBraveShieldsDown(frame, secondary_url) ||
+  allow = allow || IsBraveShieldsDownForFrame() ||
           IsScriptTemporilyAllowed(secondary_url);
 
   if (!allow) {
@@ -232,10 +241,42 @@ bool BraveContentSettingsAgentImpl::IsBraveShieldsDown(
              frame, secondary_url, content_setting_rules_->brave_shields_rules);
 }
 
+bool BraveContentSettingsAgentImpl::IsBraveShieldsDownForFrame() {
+  ClearShieldsSettingsCacheIfStale();
+  if (!cached_brave_shields_down_) {
+    blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
+    cached_brave_shields_down_ = IsBraveShieldsDown(
+        frame, url::Origin(frame->GetSecurityOrigin()).GetURL());
+  }
+  return *cached_brave_shields_down_;
+}
+
+void BraveContentSettingsAgentImpl::ClearShieldsSettingsCacheIfStale() {
+  if (cached_rules_generation_ != g_content_setting_rules_generation) {
+    ClearShieldsSettingsCache();
+    cached_rules_generation_ = g_content_setting_rules_generation;
+  }
+}
+
+void BraveContentSettingsAgentImpl::ClearShieldsSettingsCache() {
+  cached_brave_shields_down_.reset();
+  cached_farbling_level_.reset();
+}
+
+void BraveContentSettingsAgentImpl::DidCommitProvisionalLoad(
+    ui::PageTransition transition) {
+  ClearShieldsSettingsCache();
+  ContentSettingsAgentImpl::DidCommitProvisionalLoad(transition);
+}
+
+void BraveContentSettingsAgentImpl::SendRendererContentSettingRules(
+    const RendererContentSettingRules& renderer_settings) {
+  ContentSettingsAgentImpl::SendRendererContentSettingRules(renderer_settings);
+  OnContentSettingRulesUpdated();
+}
+
 bool BraveContentSettingsAgentImpl::AllowFingerprinting() {
-  blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
-  const GURL secondary_url(url::Origin(frame->GetSecurityOrigin()).GetURL());
-  if (IsBraveShieldsDown(frame, secondary_url)) {
+  if (IsBraveShieldsDownForFrame()) {
     return true;
   }
 
@@ -288,12 +329,15 @@ bool BraveContentSettingsAgentImpl::IsFirstPartyCosmeticFilteringEnabled(
 }
 
 BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
+  ClearShieldsSettingsCacheIfStale();
+  if (cached_farbling_level_)
+    return *cached_farbling_level_;
+
   blink::WebLocalFrame* frame = render_frame()->GetWebFrame();
 
   ContentSetting setting = CONTENT_SETTING_DEFAULT;
   if (content_setting_rules_) {
-    if (IsBraveShieldsDown(frame,
-                           url::Origin(frame->GetSecurityOrigin()).GetURL())) {
+    if (IsBraveShieldsDownForFrame()) {
       setting = CONTENT_SETTING_ALLOW;
     } else {
       setting = brave_shields::GetBraveFPContentSettingFromRules(
@@ -303,14 +347,15 @@ BraveFarblingLevel BraveContentSettingsAgentImpl::GetBraveFarblingLevel() {
 
   if (setting == CONTENT_SETTING_BLOCK) {
     VLOG(1) << "farbling level MAXIMUM";
-    return BraveFarblingLevel::MAXIMUM;
+    cached_farbling_level_ = BraveFarblingLevel::MAXIMUM;
   } else if (setting == CONTENT_SETTING_ALLOW) {
     VLOG(1) << "farbling level OFF";
-    return BraveFarblingLevel::OFF;
+    cached_farbling_level_ = BraveFarblingLevel::OFF;
   } else {
     VLOG(1) << "farbling level BALANCED";
-    return BraveFarblingLevel::BALANCED;
+    cached_farbling_level_ = BraveFarblingLevel::BALANCED;
   }
+  return *cached_farbling_level_;
 }
 
 bool BraveContentSettingsAgentImpl::AllowAutoplay(bool play_requested) {
@@ -21,7 +21,7 @@
 #include "mojo/public/cpp/bindings/associated_receiver_set.h"
 #include "mojo/public/cpp/bindings/associated_remote.h"
 #include "mojo/public/cpp/bindings/pending_associated_receiver.h"
-
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
 
 namespace blink {
@@ -47,6 +47,10 @@ class BraveContentSettingsAgentImpl
 
   bool IsFirstPartyCosmeticFilteringEnabled(const GURL& url) override;
 
+  // Called when the browser pushes new content setting rules to this
+  // renderer, which updates them in place for all frames.
+  static void OnContentSettingRulesUpdated();
+
  protected:
   bool AllowScript(bool enabled_per_settings) override;
   bool AllowScriptFromSource(bool enabled_per_settings,
@@ -75,6 +79,20 @@ class BraveContentSettingsAgentImpl
   bool IsBraveShieldsDown(const blink::WebFrame* frame,
                           const GURL& secondary_url);
 
+  // Same as IsBraveShieldsDown() for this frame's own origin, memoized for
+  // the current document and rules.
+  bool IsBraveShieldsDownForFrame();
+
+  // Drops the memoized shields state if the content setting rules changed
+  // since it was computed.
+  void ClearShieldsSettingsCacheIfStale();
+  void ClearShieldsSettingsCache();
+
+  // content_settings::ContentSettingsAgentImpl.
+  void DidCommitProvisionalLoad(ui::PageTransition transition) override;
+  void SendRendererContentSettingRules(
+      const RendererContentSettingRules& renderer_settings) override;
+
   bool IsScriptTemporilyAllowed(const GURL& script_url);
 
   // brave_shields::mojom::BraveShields.
@@ -104,6 +122,13 @@ class BraveContentSettingsAgentImpl
   base::flat_map<url::Origin, blink::WebSecurityOrigin>
       cached_ephemeral_storage_origins_;
 
+  // Shields state for the current document. Farbling code asks for these on
+  // every canvas, audio and WebGL readback, so they are computed once and
+  // dropped when a new document commits or the rules generation changes.
+  absl::optional<bool> cached_brave_shields_down_;
+  absl::optional<BraveFarblingLevel> cached_farbling_level_;
+  uint64_t cached_rules_generation_ = 0;
+
   mojo::AssociatedRemote<brave_shields::mojom::BraveShieldsHost>
       brave_shields_remote_;
 
@@ -7,6 +7,9 @@
 
 #include "base/feature_list.h"
 #include "base/path_service.h"
+#include "base/run_loop.h"
+#include "base/test/test_timeouts.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "brave/browser/brave_content_browser_client.h"
 #include "brave/components/brave_shields/browser/brave_shields_util.h"
 #include "brave/components/brave_shields/common/brave_shield_constants.h"
@@ -308,6 +311,22 @@ class BraveContentSettingsAgentImplBrowserTest : public InProcessBrowserTest {
     return ChildFrameAt(contents()->GetPrimaryMainFrame(), 0);
   }
 
+  // Content setting rules reach the renderer asynchronously, so a document
+  // that is already loaded picks up changes to them some time later.
+  void WaitForImageDataHash(int expected_hash) {
+    while (true) {
+      int hash = -1;
+      ASSERT_TRUE(
+          ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+      if (hash == expected_hash)
+        return;
+      base::RunLoop run_loop;
+      base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+          FROM_HERE, run_loop.QuitClosure(), TestTimeouts::tiny_timeout());
+      run_loop.Run();
+    }
+  }
+
   template <typename T>
   std::string ExecScriptGetStr(const std::string& script, T* frame) {
     std::string value;
@@ -550,6 +569,49 @@ IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplV2BrowserTest,
   EXPECT_EQ(kExpectedImageDataHashFarblingOff, hash);
 }
 
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplV2BrowserTest,
+                       FarblingLevelFollowsShieldsAcrossLoads) {
+  // Repeated readbacks in the same document use the same farbling level.
+  NavigateToPageWithIframe();
+  for (int i = 0; i < 3; ++i) {
+    int hash = -1;
+    EXPECT_TRUE(
+        ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+    EXPECT_EQ(kExpectedImageDataHashFarblingBalanced, hash);
+  }
+
+  // Dropping shields is picked up by the next document in the same frame.
+  ShieldsDown();
+  NavigateToPageWithIframe();
+  int hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingOff, hash);
+
+  ShieldsUp();
+  NavigateToPageWithIframe();
+  hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingBalanced, hash);
+}
+
+IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplV2BrowserTest,
+                       FarblingLevelFollowsRulesChangedAfterCommit) {
+  NavigateToPageWithIframe();
+  int hash = -1;
+  EXPECT_TRUE(
+      ExecuteScriptAndExtractInt(contents(), kGetImageDataScript, &hash));
+  EXPECT_EQ(kExpectedImageDataHashFarblingBalanced, hash);
+
+  // The document already committed follows the new rules once they arrive.
+  ShieldsDown();
+  WaitForImageDataHash(kExpectedImageDataHashFarblingOff);
+
+  ShieldsUp();
+  WaitForImageDataHash(kExpectedImageDataHashFarblingBalanced);
+}
+
 IN_PROC_BROWSER_TEST_F(BraveContentSettingsAgentImplV2BrowserTest,
                        CanvasIsPointInPath) {
   bool isPointInPath;
@@ -7,6 +7,7 @@
 
 #include "base/bind.h"
 #include "base/logging.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/time/time.h"
 #include "brave/components/core_metrics/pref_names.h"
 #include "brave/components/p3a_utils/bucket.h"
@@ -61,8 +62,7 @@ void CoreMetricsService::RegisterPrefs(PrefRegistrySimple* registry) {
 void CoreMetricsService::IncrementPagesLoadedCount() {
   VLOG(2) << "CoreMetricsService: increment page load count";
   if (pages_loaded_storage_ == nullptr) {
-    pages_loaded_storage_ = std::make_unique<WeeklyStorage>(
-        local_state_, kCoreMetricsPagesLoadedCount);
+    CreatePagesLoadedStorage();
   }
   pages_loaded_storage_->AddDelta(1);
 }
@@ -82,8 +82,7 @@ void CoreMetricsService::ReportPagesLoaded() {
   // Stores a global count in local state to
   // capture page loads across all profiles.
   if (pages_loaded_storage_ == nullptr) {
-    pages_loaded_storage_ = std::make_unique<WeeklyStorage>(
-        local_state_, kCoreMetricsPagesLoadedCount);
+    CreatePagesLoadedStorage();
   }
   uint64_t count = pages_loaded_storage_->GetPeriodSum();
   p3a_utils::RecordToHistogramBucket(kPagesLoadedHistogramName,
@@ -91,6 +90,14 @@ void CoreMetricsService::ReportPagesLoaded() {
   VLOG(2) << "CoreMetricsService: pages loaded report, count = " << count;
 }
 
+void CoreMetricsService::CreatePagesLoadedStorage() {
+  pages_loaded_storage_ = std::make_unique<WeeklyStorage>(
+      local_state_, kCoreMetricsPagesLoadedCount);
+  // Every page load bumps the count, so don't write local state each time.
+  pages_loaded_storage_->EnableDeferredSaves(
+      base::SequencedTaskRunnerHandle::Get());
+}
+
 void CoreMetricsService::OnDomainDiversityResult(
     std::vector<history::DomainMetricSet> metrics) {
   if (metrics.size() == 0) {
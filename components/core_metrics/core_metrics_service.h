@@ -40,6 +40,7 @@ class CoreMetricsService : public KeyedService {
  private:
   void ReportDomainsLoaded();
   void ReportPagesLoaded();
+  void CreatePagesLoadedStorage();
 
   void OnDomainDiversityResult(std::vector<history::DomainMetricSet> metrics);
 
@@ -0,0 +1,66 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/renderer/class_id_collector.h"
+
+#include <utility>
+
+#include "base/check.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+
+namespace cosmetic_filters {
+
+ClassIdCollector::ClassIdCollector() = default;
+
+ClassIdCollector::~ClassIdCollector() = default;
+
+void ClassIdCollector::AddClassAttribute(base::StringPiece value) {
+  for (const auto& class_name :
+       base::SplitStringPiece(value, base::kWhitespaceASCII,
+                              base::TRIM_WHITESPACE,
+                              base::SPLIT_WANT_NONEMPTY)) {
+    AddClass(class_name);
+  }
+}
+
+void ClassIdCollector::AddClass(base::StringPiece class_name) {
+  if (class_name.empty())
+    return;
+  auto result = seen_classes_.emplace(class_name);
+  if (result.second)
+    pending_classes_.push_back(*result.first);
+}
+
+void ClassIdCollector::AddId(base::StringPiece id) {
+  if (id.empty())
+    return;
+  auto result = seen_ids_.emplace(id);
+  if (result.second)
+    pending_ids_.push_back(*result.first);
+}
+
+bool ClassIdCollector::HasPending() const {
+  return !pending_classes_.empty() || !pending_ids_.empty();
+}
+
+void ClassIdCollector::TakePending(std::vector<std::string>* classes,
+                                   std::vector<std::string>* ids) {
+  DCHECK(classes);
+  DCHECK(ids);
+  *classes = std::move(pending_classes_);
+  *ids = std::move(pending_ids_);
+  pending_classes_.clear();
+  pending_ids_.clear();
+}
+
+void ClassIdCollector::Reset() {
+  seen_classes_.clear();
+  seen_ids_.clear();
+  pending_classes_.clear();
+  pending_ids_.clear();
+}
+
+}  // namespace cosmetic_filters
@@ -0,0 +1,53 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_CLASS_ID_COLLECTOR_H_
+#define BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_CLASS_ID_COLLECTOR_H_
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "base/strings/string_piece.h"
+
+namespace cosmetic_filters {
+
+// ClassIdCollector keeps track of the class and id tokens that were already
+// sent to the browser for the current document, and accumulates the new ones
+// until the next batch is taken. It is the single place where tokens are
+// deduplicated, regardless of whether they came from a native document scan
+// or from the mutation observer in content_cosmetic.ts.
+class ClassIdCollector {
+ public:
+  ClassIdCollector();
+  ~ClassIdCollector();
+
+  ClassIdCollector(const ClassIdCollector&) = delete;
+  ClassIdCollector& operator=(const ClassIdCollector&) = delete;
+
+  // Splits a `class` attribute value on ASCII whitespace and queues the
+  // tokens that haven't been seen yet.
+  void AddClassAttribute(base::StringPiece value);
+  void AddClass(base::StringPiece class_name);
+  void AddId(base::StringPiece id);
+
+  bool HasPending() const;
+  // Moves the queued tokens into |classes| and |ids|.
+  void TakePending(std::vector<std::string>* classes,
+                   std::vector<std::string>* ids);
+
+  // Forgets all the tokens, used when a new document is committed.
+  void Reset();
+
+ private:
+  std::unordered_set<std::string> seen_classes_;
+  std::unordered_set<std::string> seen_ids_;
+  std::vector<std::string> pending_classes_;
+  std::vector<std::string> pending_ids_;
+};
+
+}  // namespace cosmetic_filters
+
+#endif  // BRAVE_COMPONENTS_COSMETIC_FILTERS_RENDERER_CLASS_ID_COLLECTOR_H_
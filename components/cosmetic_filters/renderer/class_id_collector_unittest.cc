@@ -0,0 +1,67 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/cosmetic_filters/renderer/class_id_collector.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+namespace cosmetic_filters {
+
+TEST(ClassIdCollectorTest, SplitsClassAttribute) {
+  ClassIdCollector collector;
+  collector.AddClassAttribute("  ad\tbanner\n ad  sidebar ");
+
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  collector.TakePending(&classes, &ids);
+  EXPECT_THAT(classes, ElementsAre("ad", "banner", "sidebar"));
+  EXPECT_THAT(ids, IsEmpty());
+}
+
+TEST(ClassIdCollectorTest, DeduplicatesAcrossBatches) {
+  ClassIdCollector collector;
+  collector.AddClass("ad");
+  collector.AddId("ad");
+  collector.AddId("");
+  EXPECT_TRUE(collector.HasPending());
+
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  collector.TakePending(&classes, &ids);
+  EXPECT_THAT(classes, ElementsAre("ad"));
+  EXPECT_THAT(ids, ElementsAre("ad"));
+  EXPECT_FALSE(collector.HasPending());
+
+  collector.AddClass("ad");
+  collector.AddId("ad");
+  EXPECT_FALSE(collector.HasPending());
+
+  collector.AddId("top");
+  collector.TakePending(&classes, &ids);
+  EXPECT_THAT(classes, IsEmpty());
+  EXPECT_THAT(ids, ElementsAre("top"));
+}
+
+TEST(ClassIdCollectorTest, ResetForgetsTokens) {
+  ClassIdCollector collector;
+  collector.AddClass("ad");
+  collector.Reset();
+  EXPECT_FALSE(collector.HasPending());
+
+  collector.AddClass("ad");
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  collector.TakePending(&classes, &ids);
+  EXPECT_THAT(classes, ElementsAre("ad"));
+}
+
+}  // namespace cosmetic_filters
@@ -9,6 +9,7 @@
 
 #include "base/bind.h"
 #include "base/feature_list.h"
+#include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
@@ -28,6 +29,7 @@
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_css_origin.h"
 #include "third_party/blink/public/web/web_document.h"
+#include "third_party/blink/public/web/web_element.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_script_source.h"
 #include "ui/base/resource/resource_bundle.h"
@@ -208,11 +210,60 @@ CosmeticFiltersJSHandler::~CosmeticFiltersJSHandler() = default;
 
 void CosmeticFiltersJSHandler::HiddenClassIdSelectors(
     const std::string& input) {
-  if (!EnsureConnected())
+  absl::optional<base::Value> input_value = base::JSONReader::Read(input);
+  if (!input_value || !input_value->is_dict())
+    return;
+
+  const base::Value::Dict& input_dict = input_value->GetDict();
+  if (const auto* classes_list = input_dict.FindList("classes")) {
+    for (const auto& class_item : *classes_list) {
+      if (class_item.is_string())
+        class_id_collector_.AddClass(class_item.GetString());
+    }
+  }
+  if (const auto* ids_list = input_dict.FindList("ids")) {
+    for (const auto& id_item : *ids_list) {
+      if (id_item.is_string())
+        class_id_collector_.AddId(id_item.GetString());
+    }
+  }
+
+  FlushPendingClassIds();
+}
+
+void CosmeticFiltersJSHandler::QueryAttrsFromDocument() {
+  TRACE_EVENT0("brave.adblock", "QueryAttrsFromDocument");
+  blink::WebDocument document = render_frame_->GetWebFrame()->GetDocument();
+  if (document.IsNull())
     return;
 
+  static const base::NoDestructor<blink::WebString> kClassAttr(
+      blink::WebString::FromASCII("class"));
+  static const base::NoDestructor<blink::WebString> kIdAttr(
+      blink::WebString::FromASCII("id"));
+  const blink::WebVector<blink::WebElement> elements =
+      document.QuerySelectorAll(blink::WebString::FromASCII("[class],[id]"));
+  for (const auto& element : elements) {
+    if (element.HasAttribute(*kClassAttr)) {
+      class_id_collector_.AddClassAttribute(
+          element.GetAttribute(*kClassAttr).Utf8());
+    }
+    if (element.HasAttribute(*kIdAttr))
+      class_id_collector_.AddId(element.GetAttribute(*kIdAttr).Utf8());
+  }
+
+  FlushPendingClassIds();
+}
+
+void CosmeticFiltersJSHandler::FlushPendingClassIds() {
+  if (!class_id_collector_.HasPending() || !EnsureConnected())
+    return;
+
+  std::vector<std::string> classes;
+  std::vector<std::string> ids;
+  class_id_collector_.TakePending(&classes, &ids);
   cosmetic_filters_resources_->HiddenClassIdSelectors(
-      input, exceptions_,
+      classes, ids, exceptions_,
       base::BindOnce(&CosmeticFiltersJSHandler::OnHiddenClassIdSelectors,
                      base::Unretained(this)));
 }
@@ -278,6 +329,10 @@ void CosmeticFiltersJSHandler::BindFunctionsToObject(
       isolate, javascript_object, "hiddenClassIdSelectors",
       base::BindRepeating(&CosmeticFiltersJSHandler::HiddenClassIdSelectors,
                           base::Unretained(this)));
+  BindFunctionToObject(
+      isolate, javascript_object, "queryAttrsFromDocument",
+      base::BindRepeating(&CosmeticFiltersJSHandler::QueryAttrsFromDocument,
+                          base::Unretained(this)));
   BindFunctionToObject(
       isolate, javascript_object, "isFirstPartyUrl",
       base::BindRepeating(&CosmeticFiltersJSHandler::OnIsFirstParty,
@@ -342,6 +397,7 @@ bool CosmeticFiltersJSHandler::ProcessURL(
   resources_dict_ = absl::nullopt;
   url_ = url;
   enabled_1st_party_cf_ = false;
+  class_id_collector_.Reset();
 
   // Trivially, don't make exceptions for malformed URLs.
   if (!EnsureConnected() || url_.is_empty() || !url_.is_valid())
@@ -13,6 +13,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "brave/components/cosmetic_filters/common/cosmetic_filters.mojom.h"
+#include "brave/components/cosmetic_filters/renderer/class_id_collector.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "mojo/public/cpp/bindings/remote.h"
@@ -61,6 +62,11 @@ class CosmeticFiltersJSHandler {
 
   // A function to be called from JS
   void HiddenClassIdSelectors(const std::string& input);
+  // Collects class and id tokens of every element in the document natively,
+  // without creating JS wrappers for each element. Called from JS.
+  void QueryAttrsFromDocument();
+  // Sends the tokens that haven't been sent for this document yet.
+  void FlushPendingClassIds();
 
   void OnUrlCosmeticResources(base::OnceClosure callback,
                               base::Value result);
@@ -82,6 +88,7 @@ class CosmeticFiltersJSHandler {
   std::vector<std::string> exceptions_;
   GURL url_;
   absl::optional<base::Value::Dict> resources_dict_;
+  ClassIdCollector class_id_collector_;
 
   // True if the content_cosmetic.bundle.js has injected in the current frame.
   bool bundle_injected_ = false;
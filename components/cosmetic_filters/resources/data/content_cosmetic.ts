@@ -604,22 +604,14 @@ const queryAttrsFromDocument = (switchToMutationObserverAtTime?: number) => {
   // @ts-expect-error
   const eventId: number | undefined = cf_worker.onQuerySelectorsBegin?.()
 
-  const elmWithClassOrId = document.querySelectorAll('[class],[id]')
-  for (const elm of elmWithClassOrId) {
-    for (const aClassName of elm.classList.values()) {
-      if (aClassName && !queriedClasses.has(aClassName)) {
-        notYetQueriedClasses.push(aClassName)
-        queriedClasses.add(aClassName)
-      }
-    }
-    const elmId = elm.getAttribute('id')
-    if (elmId && !queriedIds.has(elmId)) {
-      notYetQueriedIds.push(elmId)
-      queriedIds.add(elmId)
-    }
-  }
-
+  // Send out anything queued from mutations first, then let the c++ side walk
+  // the document. It deduplicates tokens per document and only sends the new
+  // ones to the browser, so there's no need to build wrappers for every
+  // element here.
   fetchNewClassIdRules()
+  // Callback to c++ renderer process
+  // @ts-expect-error
+  cf_worker.queryAttrsFromDocument()
 
   if (eventId) {
     // Callback to c++ renderer process
@@ -6,12 +6,13 @@
 #include "brave/components/debounce/browser/debounce_component_installer.h"
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/base_paths.h"
 #include "base/bind.h"
 #include "base/command_line.h"
-#include "base/containers/flat_set.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
 #include "base/task/thread_pool.h"
@@ -28,6 +29,21 @@ namespace debounce {
 const char kDebounceConfigFile[] = "debounce.json";
 const char kDebounceConfigFileVersion[] = "1";
 
+namespace {
+
+// Reading and parsing are both done off the UI thread; the rules file is
+// large enough that building the URL pattern sets and the host index shows
+// up on startup.
+base::expected<
+    std::pair<std::vector<std::unique_ptr<DebounceRule>>, DebounceRuleIndex>,
+    std::string>
+ReadAndParseRules(const base::FilePath& dat_file_path) {
+  return DebounceRule::ParseRules(
+      brave_component_updater::GetDATFileAsString(dat_file_path));
+}
+
+}  // namespace
+
 DebounceComponentInstaller::DebounceComponentInstaller(
     LocalDataFilesService* local_data_files_service)
     : LocalDataFilesObserver(local_data_files_service) {}
@@ -38,23 +54,21 @@ void DebounceComponentInstaller::LoadDirectlyFromResourcePath() {
   base::FilePath dat_file_path = resource_dir_.AppendASCII(kDebounceConfigFile);
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE, {base::MayBlock()},
-      base::BindOnce(&brave_component_updater::GetDATFileAsString,
-                     dat_file_path),
-      base::BindOnce(&DebounceComponentInstaller::OnDATFileDataReady,
+      base::BindOnce(&ReadAndParseRules, dat_file_path),
+      base::BindOnce(&DebounceComponentInstaller::OnRulesParsed,
                      weak_factory_.GetWeakPtr()));
 }
 
-void DebounceComponentInstaller::OnDATFileDataReady(
-    const std::string& contents) {
-  auto parsed_rules = DebounceRule::ParseRules(contents);
+void DebounceComponentInstaller::OnRulesParsed(
+    base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
+                             DebounceRuleIndex>,
+                   std::string> parsed_rules) {
   if (!parsed_rules.has_value()) {
     LOG(WARNING) << parsed_rules.error();
     return;
   }
-  rules_.clear();
-  host_cache_.clear();
   rules_ = std::move(parsed_rules.value().first);
-  host_cache_ = parsed_rules.value().second;
+  rule_index_ = std::move(parsed_rules.value().second);
   for (Observer& observer : observers_)
     observer.OnRulesReady(this);
 }
@@ -40,10 +40,38 @@ const int64_t kMaxMemoryPerRegexPattern = 2 << 11;
 // Max size of a URL is capped anyway.
 // Also cap the length of regex pattern to be extra safe
 const int64_t kMaxLengthRegexPattern = 200;
+
+std::unique_ptr<re2::RE2> CompileParamRegex(const std::string& pattern) {
+  if (pattern.length() > kMaxLengthRegexPattern) {
+    VLOG(1) << "Debounce regex pattern exceeds max length: "
+            << kMaxLengthRegexPattern;
+    return nullptr;
+  }
+  re2::RE2::Options options;
+  options.set_max_mem(kMaxMemoryPerRegexPattern);
+  auto pattern_regex = std::make_unique<re2::RE2>(pattern, options);
+
+  if (!pattern_regex->ok()) {
+    VLOG(1) << "Debounce rule has param: " << pattern
+            << " which is an invalid regex pattern";
+    return nullptr;
+  }
+  if (pattern_regex->NumberOfCapturingGroups() < 1) {
+    VLOG(1) << "Debounce rule has param: " << pattern
+            << " which captures < 1 groups";
+    return nullptr;
+  }
+  return pattern_regex;
+}
 }  // namespace
 
 namespace debounce {
 
+DebounceRuleIndex::DebounceRuleIndex() = default;
+DebounceRuleIndex::DebounceRuleIndex(DebounceRuleIndex&&) = default;
+DebounceRuleIndex& DebounceRuleIndex::operator=(DebounceRuleIndex&&) = default;
+DebounceRuleIndex::~DebounceRuleIndex() = default;
+
 DebounceRule::DebounceRule()
     : action_(kDebounceNoAction), prepend_scheme_(kDebounceNoSchemePrepend) {}
 
@@ -128,9 +156,9 @@ bool DebounceRule::IsSameETLDForDebounce(const GURL& url1, const GURL& url2) {
 }
 
 // static
-base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                         base::flat_set<std::string>>,
-               std::string>
+base::expected<
+    std::pair<std::vector<std::unique_ptr<DebounceRule>>, DebounceRuleIndex>,
+    std::string>
 DebounceRule::ParseRules(const std::string& contents) {
   if (contents.empty()) {
     return base::unexpected("Could not obtain debounce configuration");
@@ -139,25 +167,31 @@ DebounceRule::ParseRules(const std::string& contents) {
   if (!root) {
     return base::unexpected("Failed to parse debounce configuration");
   }
-  std::vector<std::string> hosts;
   std::vector<std::unique_ptr<DebounceRule>> rules;
+  std::vector<std::string> hosts;
+  DebounceRuleIndex index;
   base::JSONValueConverter<DebounceRule> converter;
   for (base::Value& it : root->GetList()) {
     std::unique_ptr<DebounceRule> rule = std::make_unique<DebounceRule>();
     if (!converter.Convert(it, rule.get()))
       continue;
+    if (rule->action_ == kDebounceRegexPath)
+      rule->param_regex_ = CompileParamRegex(rule->param_);
+
     for (const URLPattern& pattern : rule->include_pattern_set()) {
-      if (!pattern.host().empty()) {
-        const std::string etldp1 =
-            DebounceRule::GetETLDForDebounce(pattern.host());
-        if (!etldp1.empty())
-          hosts.push_back(std::move(etldp1));
-      }
+      if (pattern.host().empty())
+        continue;
+      std::string etldp1 = DebounceRule::GetETLDForDebounce(pattern.host());
+      if (!etldp1.empty())
+        hosts.push_back(std::move(etldp1));
     }
+    index.include_matcher.AddPatterns(rule->include_pattern_set(),
+                                      rules.size());
     rules.push_back(std::move(rule));
   }
+  index.hosts = base::flat_set<std::string>(std::move(hosts));
   return std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                   base::flat_set<std::string>>(std::move(rules), hosts);
+                   DebounceRuleIndex>(std::move(rules), std::move(index));
 }
 
 bool DebounceRule::CheckPrefForRule(const PrefService* prefs) const {
@@ -177,29 +211,11 @@ bool DebounceRule::CheckPrefForRule(const PrefService* prefs) const {
   return true;
 }
 
-bool DebounceRule::ValidateAndParsePatternRegex(
-    const std::string& pattern,
-    const std::string& path,
-    std::string* parsed_value) const {
-  if (pattern.length() > kMaxLengthRegexPattern) {
-    VLOG(1) << "Debounce regex pattern exceeds max length: "
-            << kMaxLengthRegexPattern;
+bool DebounceRule::ParsePathWithParamRegex(const std::string& path,
+                                           std::string* parsed_value) const {
+  if (!param_regex_)
     return false;
-  }
-  re2::RE2::Options options;
-  options.set_max_mem(kMaxMemoryPerRegexPattern);
-  const re2::RE2 pattern_regex(pattern, options);
-
-  if (!pattern_regex.ok()) {
-    VLOG(1) << "Debounce rule has param: " << pattern
-            << " which is an invalid regex pattern";
-    return false;
-  }
-  if (pattern_regex.NumberOfCapturingGroups() < 1) {
-    VLOG(1) << "Debounce rule has param: " << pattern
-            << " which captures < 1 groups";
-    return false;
-  }
+  const re2::RE2& pattern_regex = *param_regex_;
 
   // Get matching capture groups by applying regex to the path
   size_t number_of_capturing_groups =
@@ -258,7 +274,7 @@ bool DebounceRule::Apply(const GURL& original_url,
     // Important: Apply param regex to ONLY the path of original URL.
     auto path = original_url.path();
 
-    if (!ValidateAndParsePatternRegex(param_, path, &unescaped_value)) {
+    if (!ParsePathWithParamRegex(path, &unescaped_value)) {
       VLOG(1) << "Debounce regex parsing failed";
       return false;
     }
@@ -16,11 +16,16 @@
 #include "base/strings/escape.h"
 #include "base/types/expected.h"
 #include "base/values.h"
+#include "brave/components/url_pattern_matcher/url_pattern_matcher.h"
 #include "components/prefs/pref_service.h"
 #include "extensions/common/url_pattern_set.h"
 
 class GURL;
 
+namespace re2 {
+class RE2;
+}  // namespace re2
+
 namespace debounce {
 
 enum DebounceAction {
@@ -36,6 +41,20 @@ enum DebouncePrependScheme {
   kDebounceSchemePrependHttps
 };
 
+// Lookup structures for finding the rules that apply to a URL.
+struct DebounceRuleIndex {
+  DebounceRuleIndex();
+  DebounceRuleIndex(DebounceRuleIndex&&);
+  DebounceRuleIndex& operator=(DebounceRuleIndex&&);
+  ~DebounceRuleIndex();
+
+  // eTLD+1s named by some include pattern. URLs on other hosts are never
+  // debounced.
+  base::flat_set<std::string> hosts;
+  // Include patterns of all rules, tagged with the index of their rule.
+  brave::URLPatternMatcher include_matcher;
+};
+
 class DebounceRule {
  public:
   DebounceRule();
@@ -49,9 +68,9 @@ class DebounceRule {
                                   DebounceAction* field);
   static bool ParsePrependScheme(base::StringPiece value,
                                  DebouncePrependScheme* field);
-  static base::expected<std::pair<std::vector<std::unique_ptr<DebounceRule>>,
-                                  base::flat_set<std::string>>,
-                        std::string>
+  static base::expected<
+      std::pair<std::vector<std::unique_ptr<DebounceRule>>, DebounceRuleIndex>,
+      std::string>
   ParseRules(const std::string& contents);
   static const std::string GetETLDForDebounce(const std::string& host);
   static bool IsSameETLDForDebounce(const GURL& url1, const GURL& url2);
@@ -67,15 +86,17 @@ class DebounceRule {
 
  private:
   bool CheckPrefForRule(const PrefService* prefs) const;
-  bool ValidateAndParsePatternRegex(const std::string& pattern,
-                                    const std::string& path,
-                                    std::string* parsed_value) const;
+  bool ParsePathWithParamRegex(const std::string& path,
+                               std::string* parsed_value) const;
   extensions::URLPatternSet include_pattern_set_;
   extensions::URLPatternSet exclude_pattern_set_;
   DebounceAction action_;
   DebouncePrependScheme prepend_scheme_;
   std::string param_;
   std::string pref_;
+  // |param_| compiled once at parse time for kDebounceRegexPath rules. Null
+  // if the pattern is invalid, in which case the rule never applies.
+  std::unique_ptr<re2::RE2> param_regex_;
 };
 
 }  // namespace debounce
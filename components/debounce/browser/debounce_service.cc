@@ -9,8 +9,7 @@
 #include <string>
 #include <vector>
 
-#include "base/containers/contains.h"
-#include "base/containers/flat_set.h"
+#include "base/check_op.h"
 #include "base/logging.h"
 #include "brave/components/debounce/browser/debounce_component_installer.h"
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
@@ -27,19 +26,21 @@ DebounceService::~DebounceService() = default;
 
 bool DebounceService::Debounce(const GURL& original_url,
                                GURL* final_url) const {
-  // Check host cache to see if this URL needs to have any debounce rules
-  // applied.
-  const base::flat_set<std::string>& host_cache =
-      component_installer_->host_cache();
+  // Hosts whose eTLD+1 no rule mentions aren't debounced at all.
+  const DebounceRuleIndex& rule_index = component_installer_->rule_index();
   const std::string etldp1 =
       DebounceRule::GetETLDForDebounce(original_url.host());
-  if (!base::Contains(host_cache, etldp1))
+  if (!rule_index.hosts.contains(etldp1))
     return false;
 
   const std::vector<std::unique_ptr<DebounceRule>>& rules =
       component_installer_->rules();
 
-  for (const std::unique_ptr<DebounceRule>& rule : rules) {
+  // Only rules with an include pattern matching the URL can apply.
+  for (size_t index :
+       rule_index.include_matcher.GetMatchingRules(original_url)) {
+    DCHECK_LT(index, rules.size());
+    const std::unique_ptr<DebounceRule>& rule = rules[index];
     if (rule->Apply(original_url, final_url, prefs_)) {
       if (original_url != *final_url) {
         return true;
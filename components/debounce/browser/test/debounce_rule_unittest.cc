@@ -445,4 +445,51 @@ TEST(DebounceRuleUnitTest, CatchMultiplePathsForSameInclude) {
   }
 }
 
+TEST(DebounceRuleUnitTest, RulesAreIndexedByHost) {
+  const std::string contents = R"json(
+
+      [{
+          "include": [
+              "*://a.test.com/*",
+              "*://b.test.com/*"
+          ],
+          "exclude": [],
+          "action": "redirect",
+          "param": "url"
+      }, {
+          "include": [
+              "*://*/*?redirect=*"
+          ],
+          "exclude": [],
+          "action": "redirect",
+          "param": "redirect"
+      }, {
+          "include": [
+              "*://example.com/*"
+          ],
+          "exclude": [],
+          "action": "regex-path",
+          "param": "^/(.*)$"
+      }]
+
+    )json";
+  auto parsed = DebounceRule::ParseRules(contents);
+  ASSERT_TRUE(parsed.has_value());
+  const DebounceRuleIndex& index = parsed.value().second;
+
+  // Only hosts named by a rule are debounced.
+  EXPECT_EQ(base::flat_set<std::string>({"example.com", "test.com"}),
+            index.hosts);
+  EXPECT_EQ(4u, index.include_matcher.size());
+
+  // Rules are looked up by their include patterns, in rule order.
+  EXPECT_EQ(std::vector<size_t>({0}), index.include_matcher.GetMatchingRules(
+                                          GURL("https://a.test.com/")));
+  EXPECT_EQ(std::vector<size_t>({1, 2}),
+            index.include_matcher.GetMatchingRules(
+                GURL("https://example.com/?redirect=x")));
+  EXPECT_EQ(std::vector<size_t>(), index.include_matcher.GetMatchingRules(
+                                       GURL("https://c.test.com/")));
+}
+
 }  // namespace debounce
@@ -6,6 +6,7 @@
 #include "brave/components/greaselion/browser/greaselion_service_impl.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -16,16 +17,20 @@
 #include "base/callback_helpers.h"
 #include "base/command_line.h"
 #include "base/containers/contains.h"
+#include "base/containers/flat_set.h"
 #include "base/feature_list.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/one_shot_event.h"
 #include "base/ranges/algorithm.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/task_runner_util.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "base/version.h"
 #include "brave/components/brave_component_updater/browser/features.h"
@@ -35,6 +40,7 @@
 #include "brave/components/version_info//version_info.h"
 #include "chrome/browser/extensions/extension_service.h"
 #include "components/version_info/version_info.h"
+#include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
 #include "extensions/browser/computed_hashes.h"
 #include "extensions/browser/extension_registry.h"
@@ -55,6 +61,13 @@ namespace {
 
 constexpr char kRunAtDocumentStart[] = "document_start";
 
+// Mixed into every rule digest. Bump this whenever the conversion below
+// changes its output so that previously cached extensions are not reused.
+constexpr char kConversionFormatVersion[] = "1";
+
+constexpr char kTraceCategory[] = "brave";
+constexpr char kUpdateTrace[] = "GreaselionUpdate";
+
 bool ShouldComputeHashesForResource(
     const base::FilePath& relative_resource_path) {
   std::vector<base::FilePath::StringType> components =
@@ -62,15 +75,150 @@ bool ShouldComputeHashesForResource(
   return !components.empty() && components[0] != extensions::kMetadataFolder;
 }
 
-// Wraps a Greaselion rule in a component. The component is stored as
-// an unpacked extension in the user data dir. Returns a valid
+// Greaselion scripts are not signed, but the public key for an extension
+// doubles as its unique identity, and we need one of those, so we add the
+// rule name to a known Brave domain and hash the result to create a public
+// key.
+std::string GetPublicKeyForRule(const std::string& script_name) {
+  char raw[crypto::kSHA256Length] = {0};
+  std::string key;
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
+      !base::FeatureList::IsEnabled(
+          brave_component_updater::kUseDevUpdaterUrl)) {
+    crypto::SHA256HashString(BUILDFLAG(UPDATER_DEV_ENDPOINT) + script_name, raw,
+                             crypto::kSHA256Length);
+  } else {
+    crypto::SHA256HashString(BUILDFLAG(UPDATER_PROD_ENDPOINT) + script_name,
+                             raw, crypto::kSHA256Length);
+  }
+  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
+  return key;
+}
+
+// Returns a digest of everything that ends up in the extension converted
+// from |rule|, including the contents of its scripts and messages, or
+// absl::nullopt if one of those files can't be read.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+absl::optional<std::string> ComputeRuleDigest(
+    const greaselion::GreaselionRule& rule) {
+  std::unique_ptr<crypto::SecureHash> hash =
+      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
+  // Length-prefix every field so that adjacent fields can't run together.
+  auto update = [&hash](base::StringPiece value) {
+    const uint64_t size = value.size();
+    hash->Update(&size, sizeof(size));
+    hash->Update(value.data(), value.size());
+  };
+
+  update(kConversionFormatVersion);
+  update(rule.name());
+  update(GetPublicKeyForRule(rule.name()));
+  update(rule.run_at());
+  update(base::NumberToString(rule.url_patterns().size()));
+  for (const auto& url_pattern : rule.url_patterns())
+    update(url_pattern);
+
+  update(base::NumberToString(rule.scripts().size()));
+  for (const auto& script : rule.scripts()) {
+    std::string contents;
+    if (!base::ReadFileToString(script, &contents)) {
+      LOG(ERROR) << "Could not read Greaselion script at path: "
+                 << script.LossyDisplayName();
+      return absl::nullopt;
+    }
+    update(script.BaseName().AsUTF8Unsafe());
+    update(contents);
+  }
+
+  if (!rule.messages().empty()) {
+    std::vector<base::FilePath> message_files;
+    base::FileEnumerator enumerator(rule.messages(), true,
+                                    base::FileEnumerator::FILES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      message_files.push_back(path);
+    }
+    std::sort(message_files.begin(), message_files.end());
+    update(base::NumberToString(message_files.size()));
+    for (const auto& path : message_files) {
+      base::FilePath relative_path;
+      std::string contents;
+      if (!rule.messages().AppendRelativePath(path, &relative_path) ||
+          !base::ReadFileToString(path, &contents)) {
+        LOG(ERROR) << "Could not read Greaselion messages at path: "
+                   << path.LossyDisplayName();
+        return absl::nullopt;
+      }
+      update(relative_path.AsUTF8Unsafe());
+      update(contents);
+    }
+  }
+
+  uint8_t digest[crypto::kSHA256Length];
+  hash->Finish(digest, sizeof(digest));
+  return base::ToLowerASCII(base::HexEncode(digest, sizeof(digest)));
+}
+
+// Computes the digest of each rule, dropping the ones whose files can't be
+// read. If |prune_cache| is true, cached extensions that none of |rules|
+// converts to anymore are deleted.
+//
+// NOTE: This function does file IO and should not be called on the UI thread.
+std::vector<std::pair<greaselion::GreaselionRule, std::string>>
+ComputeRuleDigestsOnTaskRunner(std::vector<greaselion::GreaselionRule> rules,
+                               const base::FilePath& install_dir,
+                               bool prune_cache) {
+  std::vector<std::pair<greaselion::GreaselionRule, std::string>> result;
+  for (auto& rule : rules) {
+    absl::optional<std::string> digest = ComputeRuleDigest(rule);
+    if (digest)
+      result.emplace_back(std::move(rule), std::move(*digest));
+  }
+
+  if (prune_cache) {
+    base::flat_set<base::FilePath::StringType> in_use;
+    for (const auto& rule_and_digest : result)
+      in_use.insert(base::FilePath::FromASCII(rule_and_digest.second).value());
+    base::FileEnumerator enumerator(
+        install_dir.AppendASCII(greaselion::kGreaselionConvertedExtensionsDir),
+        false, base::FileEnumerator::DIRECTORIES);
+    for (base::FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      if (!base::Contains(in_use, path.BaseName().value()))
+        base::DeletePathRecursively(path);
+    }
+  }
+  return result;
+}
+
+// Wraps a Greaselion rule in a component. The component is stored as an
+// unpacked extension in the user data dir, in a directory named after
+// |digest|, and reused as is if it's already there. Returns a valid
 // extension that the caller should take ownership of, or nullptr.
 //
 // NOTE: This function does file IO and should not be called on the UI thread.
 absl::optional<greaselion::GreaselionServiceImpl::GreaselionConvertedExtension>
 ConvertGreaselionRuleToExtensionOnTaskRunner(
     const greaselion::GreaselionRule& rule,
+    const std::string& digest,
     const base::FilePath& install_dir) {
+  const base::FilePath extension_dir =
+      install_dir.AppendASCII(greaselion::kGreaselionConvertedExtensionsDir)
+          .AppendASCII(digest);
+  std::string error;
+  if (base::PathExists(extension_dir.Append(extensions::kManifestFilename))) {
+    scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
+        extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS,
+        &error);
+    if (extension.get())
+      return std::make_pair(extension, extension_dir);
+    // The cached copy is unusable, convert the rule again below.
+    LOG(ERROR) << "Could not load cached Greaselion extension: " << error;
+  }
+
   base::FilePath install_temp_dir =
       extensions::file_util::GetInstallTempDir(install_dir);
   if (install_temp_dir.empty()) {
@@ -91,31 +239,12 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
   // see kModernManifestVersion in src/extensions/common/extension.cc
   root.SetByDottedPath(extensions::manifest_keys::kManifestVersion, 2);
 
-  // Create the public key.
-  // Greaselion scripts are not signed, but the public key for an extension
-  // doubles as its unique identity, and we need one of those, so we add the
-  // rule name to a known Brave domain and hash the result to create a
-  // public key.
-  char raw[crypto::kSHA256Length] = {0};
-  std::string key;
   std::string script_name = rule.name();
-  const base::CommandLine& command_line =
-      *base::CommandLine::ForCurrentProcess();
-  if (!command_line.HasSwitch(brave_component_updater::kUseGoUpdateDev) &&
-      !base::FeatureList::IsEnabled(
-          brave_component_updater::kUseDevUpdaterUrl)) {
-    crypto::SHA256HashString(BUILDFLAG(UPDATER_DEV_ENDPOINT) + script_name, raw,
-                             crypto::kSHA256Length);
-  } else {
-    crypto::SHA256HashString(BUILDFLAG(UPDATER_PROD_ENDPOINT) + script_name,
-                             raw, crypto::kSHA256Length);
-  }
-  base::Base64Encode(base::StringPiece(raw, crypto::kSHA256Length), &key);
-
   root.SetByDottedPath(extensions::manifest_keys::kName, script_name);
   root.SetByDottedPath(extensions::manifest_keys::kVersion, "1.0");
   root.SetByDottedPath(extensions::manifest_keys::kDescription, "");
-  root.SetByDottedPath(extensions::manifest_keys::kPublicKey, key);
+  root.SetByDottedPath(extensions::manifest_keys::kPublicKey,
+                       GetPublicKeyForRule(script_name));
   root.SetByDottedPath("incognito",
                        extensions::manifest_values::kIncognitoNotAllowed);
 
@@ -181,13 +310,23 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
     }
   }
 
-  std::string error;
+  // Move the finished extension into the cache before loading it, so that
+  // the extension's path is its final location.
+  if (!base::DeletePathRecursively(extension_dir) ||
+      !base::CreateDirectory(extension_dir.DirName()) ||
+      !base::Move(temp_dir.GetPath(), extension_dir)) {
+    LOG(ERROR) << "Could not move Greaselion extension into the cache";
+    return absl::nullopt;
+  }
+  temp_dir.Take();
+
   scoped_refptr<Extension> extension = extensions::file_util::LoadExtension(
-      temp_dir.GetPath(), ManifestLocation::kComponent, Extension::NO_FLAGS,
+      extension_dir, ManifestLocation::kComponent, Extension::NO_FLAGS,
       &error);
   if (!extension.get()) {
     LOG(ERROR) << "Could not load Greaselion extension";
     LOG(ERROR) << error;
+    base::DeletePathRecursively(extension_dir);
     return absl::nullopt;
   }
 
@@ -204,21 +343,15 @@ ConvertGreaselionRuleToExtensionOnTaskRunner(
             extensions::file_util::GetComputedHashesPath(extension->path()));
   }
 
-  // Take ownership of this temporary directory; the service will delete it on
-  // exit
-  return std::make_pair(extension, temp_dir.Take());
-}
-
-void DeleteExtensionDirs(const std::vector<base::FilePath>& extension_dirs) {
-  for (const auto& extension_dir : extension_dirs) {
-    base::DeletePathRecursively(extension_dir);
-  }
+  return std::make_pair(extension, extension_dir);
 }
 
 }  // namespace
 
 namespace greaselion {
 
+const char kGreaselionConvertedExtensionsDir[] = "Extensions";
+
 GreaselionServiceImpl::GreaselionServiceImpl(
     GreaselionDownloadService* download_service,
     const base::FilePath& install_directory,
@@ -251,8 +384,6 @@ GreaselionServiceImpl::~GreaselionServiceImpl() = default;
 void GreaselionServiceImpl::Shutdown() {
   download_service_->RemoveObserver(this);
   extension_registry_->RemoveObserver(this);
-  task_runner_->PostTask(FROM_HERE,
-                         base::BindOnce(&DeleteExtensionDirs, extension_dirs_));
 }
 
 bool GreaselionServiceImpl::IsGreaselionExtension(const std::string& id) {
@@ -265,75 +396,103 @@ GreaselionServiceImpl::GetExtensionIdsForTesting() {
 }
 
 void GreaselionServiceImpl::UpdateInstalledExtensions() {
+  // Updates requested while one is in progress are folded into it, so time
+  // the whole run from the first request until observers are notified.
+  if (update_started_at_.is_null()) {
+    update_started_at_ = base::TimeTicks::Now();
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(kTraceCategory, kUpdateTrace,
+                                      TRACE_ID_LOCAL(this));
+  }
   if (update_in_progress_) {
     update_pending_ = true;
     return;
   }
   update_in_progress_ = true;
-  if (greaselion_extensions_.empty()) {
-    // No Greaselion extensions are currently installed, so we can move on to
-    // the install phase immediately.
-    CreateAndInstallExtensions();
-    return;
-  }
 
-  // Make a copy of greaselion_extensions_ to iterate while the original vector
-  // changes.
-  std::vector<extensions::ExtensionId> extensions = greaselion_extensions_;
-  for (auto id : extensions) {
-    // We need to unload all the Greaselion extensions that are already
-    // installed. OnExtensionUnloaded will be called on each extension, where we
-    // will update the greaselion_extensions_ set. Once it's empty, that
-    // callback will call CreateAndInstallExtensions().
-    extension_service_->UnloadExtension(
-        id, extensions::UnloadedExtensionReason::UPDATE);
+  // Digest every usable rule, not only the ones that match the current
+  // state, so that cached extensions for rules that are merely disabled
+  // survive cache pruning.
+  std::vector<GreaselionRule> rules;
+  for (const std::unique_ptr<GreaselionRule>& rule :
+       *download_service_->rules()) {
+    if (!rule->has_unknown_preconditions())
+      rules.push_back(*rule);
   }
+  // Only prune once the rules are known, and only once per session: other
+  // profiles share the cache and may still be using the previous digests.
+  const bool prune_cache = !cache_pruned_ && !rules.empty();
+  cache_pruned_ |= prune_cache;
+  base::PostTaskAndReplyWithResult(
+      task_runner_.get(), FROM_HERE,
+      base::BindOnce(&ComputeRuleDigestsOnTaskRunner, std::move(rules),
+                     install_directory_, prune_cache),
+      base::BindOnce(&GreaselionServiceImpl::OnRuleDigestsComputed,
+                     weak_factory_.GetWeakPtr()));
 }
 
-void GreaselionServiceImpl::CreateAndInstallExtensions() {
-  DCHECK(greaselion_extensions_.empty());
+void GreaselionServiceImpl::OnRuleDigestsComputed(
+    std::vector<std::pair<GreaselionRule, std::string>> rules_and_digests) {
   DCHECK(update_in_progress_);
   all_rules_installed_successfully_ = true;
   pending_installs_ = 0;
 
-  // At this point, any GL extensions that were previously loaded have now been
-  // unloaded. We can now clean up their corresponding temp folders.
-  if (!extension_dirs_.empty()) {
-    task_runner_->PostTask(
-        FROM_HERE,
-        base::BindOnce(&DeleteExtensionDirs, std::move(extension_dirs_)));
+  // The converted extension each rule should have loaded for the current
+  // state, keyed by rule name.
+  std::map<std::string, std::string> wanted_digests;
+  for (const auto& [rule, digest] : rules_and_digests) {
+    if (rule.Matches(state_, browser_version_))
+      wanted_digests[rule.name()] = digest;
   }
 
-  std::vector<std::unique_ptr<GreaselionRule>>* rules =
-      download_service_->rules();
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      pending_installs_ += 1;
+  // Unload the extensions of rules that no longer match, or whose content
+  // changed. Those that are unchanged stay loaded.
+  std::vector<extensions::ExtensionId> to_unload;
+  for (auto it = installed_rules_.begin(); it != installed_rules_.end();) {
+    const auto wanted = wanted_digests.find(it->first);
+    if (wanted != wanted_digests.end() && wanted->second == it->second.digest) {
+      ++it;
+      continue;
     }
+    to_unload.push_back(it->second.extension_id);
+    it = installed_rules_.erase(it);
   }
-  if (!pending_installs_) {
-    // no rules match, nothing else to do
+  for (const auto& id : to_unload) {
+    extension_service_->UnloadExtension(
+        id, extensions::UnloadedExtensionReason::UPDATE);
+  }
+
+  std::vector<std::pair<GreaselionRule, std::string>> to_install;
+  for (auto& [rule, digest] : rules_and_digests) {
+    if (!base::Contains(wanted_digests, rule.name()) ||
+        base::Contains(installed_rules_, rule.name())) {
+      continue;
+    }
+    to_install.emplace_back(std::move(rule), std::move(digest));
+  }
+  if (to_install.empty()) {
+    // nothing changed, or no rules match; nothing else to do
     MaybeNotifyObservers();
     return;
   }
-  for (const std::unique_ptr<GreaselionRule>& rule : *rules) {
-    if (rule->Matches(state_, browser_version_) &&
-        rule->has_unknown_preconditions() == false) {
-      // Convert script file to component extension. This must run on extension
-      // file task runner, which was passed in in the constructor.
-      GreaselionRule rule_copy(*rule);
-      base::PostTaskAndReplyWithResult(
-          task_runner_.get(), FROM_HERE,
-          base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
-                         rule_copy, install_directory_),
-          base::BindOnce(&GreaselionServiceImpl::PostConvert,
-                         weak_factory_.GetWeakPtr()));
-    }
+
+  pending_installs_ = to_install.size();
+  for (auto& [rule, digest] : to_install) {
+    // Convert script file to component extension, or pick up the cached
+    // conversion. This must run on extension file task runner, which was
+    // passed in in the constructor.
+    const std::string name = rule.name();
+    base::PostTaskAndReplyWithResult(
+        task_runner_.get(), FROM_HERE,
+        base::BindOnce(&ConvertGreaselionRuleToExtensionOnTaskRunner,
+                       std::move(rule), digest, install_directory_),
+        base::BindOnce(&GreaselionServiceImpl::PostConvert,
+                       weak_factory_.GetWeakPtr(), name, digest));
   }
 }
 
 void GreaselionServiceImpl::PostConvert(
+    const std::string& rule_name,
+    const std::string& digest,
     absl::optional<GreaselionConvertedExtension> converted_extension) {
   if (!converted_extension) {
     all_rules_installed_successfully_ = false;
@@ -341,8 +500,9 @@ void GreaselionServiceImpl::PostConvert(
     MaybeNotifyObservers();
     LOG(ERROR) << "Could not load Greaselion script";
   } else {
-    greaselion_extensions_.push_back(converted_extension->first->id());
-    extension_dirs_.push_back(converted_extension->second);
+    const extensions::ExtensionId& id = converted_extension->first->id();
+    installed_rules_[rule_name] = {id, digest};
+    greaselion_extensions_.push_back(id);
     extension_system_->ready().Post(
         FROM_HERE, base::BindOnce(&GreaselionServiceImpl::Install,
                                   weak_factory_.GetWeakPtr(),
@@ -377,9 +537,14 @@ void GreaselionServiceImpl::OnExtensionUnloaded(
     return;
   }
   greaselion_extensions_.erase(index);
-  if (update_in_progress_ && greaselion_extensions_.empty()) {
-    // It's time!
-    CreateAndInstallExtensions();
+  // Forget the rule's conversion so the next update installs it again, e.g.
+  // if the extension was unloaded from outside this service.
+  for (auto it = installed_rules_.begin(); it != installed_rules_.end();
+       ++it) {
+    if (it->second.extension_id == extension->id()) {
+      installed_rules_.erase(it);
+      break;
+    }
   }
 }
 
@@ -399,6 +564,11 @@ void GreaselionServiceImpl::MaybeNotifyObservers() {
       update_pending_ = false;
       UpdateInstalledExtensions();
     } else {
+      TRACE_EVENT_NESTABLE_ASYNC_END0(kTraceCategory, kUpdateTrace,
+                                      TRACE_ID_LOCAL(this));
+      VLOG(1) << "Greaselion extensions updated in "
+              << (base::TimeTicks::Now() - update_started_at_);
+      update_started_at_ = base::TimeTicks();
       for (auto& observer : observers_)
         observer.OnExtensionsReady(this, all_rules_installed_successfully_);
     }
@@ -16,6 +16,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/path_service.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "base/version.h"
 #include "brave/components/greaselion/browser/greaselion_download_service.h"
 #include "brave/components/greaselion/browser/greaselion_service.h"
@@ -36,6 +37,10 @@ class ExtensionSystem;
 
 namespace greaselion {
 
+// Directory under the install directory where converted extensions are
+// cached across sessions, in one subdirectory per rule content digest.
+extern const char kGreaselionConvertedExtensionsDir[];
+
 class GreaselionServiceImpl : public GreaselionService,
                               public GreaselionDownloadService::Observer {
  public:
@@ -73,8 +78,11 @@ class GreaselionServiceImpl : public GreaselionService,
 
  private:
   void SetBrowserVersionForTesting(const base::Version& version) override;
-  void CreateAndInstallExtensions();
+  void OnRuleDigestsComputed(
+      std::vector<std::pair<GreaselionRule, std::string>> rules_and_digests);
   void PostConvert(
+      const std::string& rule_name,
+      const std::string& digest,
       absl::optional<GreaselionConvertedExtension> converted_extension);
   void Install(scoped_refptr<extensions::Extension> extension);
   void MaybeNotifyObservers();
@@ -98,7 +106,15 @@ class GreaselionServiceImpl : public GreaselionService,
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::ObserverList<GreaselionService::Observer> observers_;
   std::vector<extensions::ExtensionId> greaselion_extensions_;
-  std::vector<base::FilePath> extension_dirs_;
+  // The converted extension loaded for each rule, keyed by rule name.
+  struct InstalledRule {
+    extensions::ExtensionId extension_id;
+    std::string digest;
+  };
+  std::map<std::string, InstalledRule> installed_rules_;
+  bool cache_pruned_ = false;
+  // When the first of the updates currently being processed was requested.
+  base::TimeTicks update_started_at_;
   base::Version browser_version_;
   base::WeakPtrFactory<GreaselionServiceImpl> weak_factory_;
 };
@@ -42,6 +42,8 @@ namespace ntp_background_images {
 namespace {
 
 constexpr int kSIComponentUpdateCheckIntervalMins = 15;
+// Room for a few full-size wallpapers plus the sponsored logos.
+constexpr size_t kMaxImageCacheSizeInBytes = 16 * 1024 * 1024;
 constexpr char kNTPManifestFile[] = "photo.json";
 constexpr char kNTPSRMappingTableFile[] = "mapping-table.json";
 
@@ -102,6 +104,7 @@ NTPBackgroundImagesService::NTPBackgroundImagesService(
     PrefService* local_pref)
     : component_update_service_(cus),
       local_pref_(local_pref),
+      image_cache_(kMaxImageCacheSizeInBytes),
       weak_factory_(this) {
 }
 
@@ -0,0 +1,131 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
+
+#include <iterator>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/task/thread_pool.h"
+
+namespace ntp_background_images {
+
+namespace {
+
+absl::optional<std::string> ReadFileToString(const base::FilePath& path) {
+  std::string contents;
+  if (!base::ReadFileToString(path, &contents))
+    return absl::optional<std::string>();
+  return contents;
+}
+
+}  // namespace
+
+NTPImageCache::NTPImageCache(size_t max_size_in_bytes)
+    : max_size_in_bytes_(max_size_in_bytes),
+      images_(decltype(images_)::NO_AUTO_EVICT),
+      memory_pressure_listener_(
+          FROM_HERE,
+          base::BindRepeating(&NTPImageCache::OnMemoryPressure,
+                              base::Unretained(this))) {}
+
+NTPImageCache::~NTPImageCache() = default;
+
+void NTPImageCache::GetImage(const base::FilePath& image_file,
+                             GetImageCallback callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  auto it = images_.Get(image_file);
+  if (it != images_.end()) {
+    std::move(callback).Run(it->second);
+    return;
+  }
+
+  auto [pending, inserted] = pending_reads_.try_emplace(image_file);
+  pending->second.push_back(std::move(callback));
+  // Only the first request for a file starts a read; the others wait for it.
+  if (inserted)
+    ReadImage(image_file);
+}
+
+void NTPImageCache::Warm(const base::FilePath& image_file) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (image_file.empty() || Contains(image_file))
+    return;
+  if (pending_reads_.try_emplace(image_file).second)
+    ReadImage(image_file);
+}
+
+void NTPImageCache::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  images_.Clear();
+  size_in_bytes_ = 0;
+  ++generation_;
+}
+
+bool NTPImageCache::Contains(const base::FilePath& image_file) const {
+  return images_.Peek(image_file) != images_.end();
+}
+
+void NTPImageCache::ReadImage(const base::FilePath& image_file) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&ReadFileToString, image_file),
+      base::BindOnce(&NTPImageCache::OnImageRead, weak_factory_.GetWeakPtr(),
+                     image_file, generation_));
+}
+
+void NTPImageCache::OnImageRead(const base::FilePath& image_file,
+                                int generation,
+                                absl::optional<std::string> contents) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  scoped_refptr<base::RefCountedString> bytes;
+  if (contents) {
+    bytes = base::MakeRefCounted<base::RefCountedString>();
+    bytes->data().swap(*contents);
+    if (generation == generation_ && bytes->size() <= max_size_in_bytes_) {
+      auto existing = images_.Peek(image_file);
+      if (existing != images_.end()) {
+        size_in_bytes_ -= existing->second->size();
+        images_.Erase(existing);
+      }
+      images_.Put(image_file, bytes);
+      size_in_bytes_ += bytes->size();
+      EvictIfNeeded();
+    }
+  }
+
+  auto pending = pending_reads_.find(image_file);
+  if (pending == pending_reads_.end())
+    return;
+  std::vector<GetImageCallback> callbacks = std::move(pending->second);
+  pending_reads_.erase(pending);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(bytes);
+}
+
+void NTPImageCache::EvictIfNeeded() {
+  while (size_in_bytes_ > max_size_in_bytes_ && !images_.empty()) {
+    auto oldest = std::prev(images_.end());
+    size_in_bytes_ -= oldest->second->size();
+    images_.Erase(oldest);
+  }
+}
+
+void NTPImageCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    return;
+  }
+  Clear();
+}
+
+}  // namespace ntp_background_images
@@ -0,0 +1,77 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
+#define BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/containers/lru_cache.h"
+#include "base/files/file_path.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace ntp_background_images {
+
+// Keeps the contents of recently used NTP image files in memory so that new
+// tab pages can be served without reading from disk. The cache is bounded by
+// the total size of the images it holds, evicts least recently used images
+// first and is emptied under memory pressure.
+class NTPImageCache {
+ public:
+  using GetImageCallback =
+      base::OnceCallback<void(scoped_refptr<base::RefCountedMemory>)>;
+
+  explicit NTPImageCache(size_t max_size_in_bytes);
+  ~NTPImageCache();
+
+  NTPImageCache(const NTPImageCache&) = delete;
+  NTPImageCache& operator=(const NTPImageCache&) = delete;
+
+  // Runs |callback| with the contents of |image_file|, reading it on the
+  // thread pool if it isn't cached yet. |callback| gets nullptr if the file
+  // can't be read.
+  void GetImage(const base::FilePath& image_file, GetImageCallback callback);
+
+  // Starts reading |image_file| into the cache if it isn't there already.
+  void Warm(const base::FilePath& image_file);
+
+  void Clear();
+
+  bool Contains(const base::FilePath& image_file) const;
+  size_t size_in_bytes() const { return size_in_bytes_; }
+
+ private:
+  void ReadImage(const base::FilePath& image_file);
+  void OnImageRead(const base::FilePath& image_file,
+                   int generation,
+                   absl::optional<std::string> contents);
+  void EvictIfNeeded();
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  const size_t max_size_in_bytes_;
+  size_t size_in_bytes_ = 0;
+  // Bumped by Clear() so that reads started before it aren't cached.
+  int generation_ = 0;
+  base::LRUCache<base::FilePath, scoped_refptr<base::RefCountedString>>
+      images_;
+  // Callbacks waiting for an image that is being read, keyed by file.
+  std::map<base::FilePath, std::vector<GetImageCallback>> pending_reads_;
+  base::MemoryPressureListener memory_pressure_listener_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<NTPImageCache> weak_factory_{this};
+};
+
+}  // namespace ntp_background_images
+
+#endif  // BRAVE_COMPONENTS_NTP_BACKGROUND_IMAGES_BROWSER_NTP_IMAGE_CACHE_H_
@@ -0,0 +1,112 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
+
+#include <string>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace ntp_background_images {
+
+class NTPImageCacheTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath WriteImage(const std::string& name,
+                            const std::string& contents) {
+    base::FilePath path = temp_dir_.GetPath().AppendASCII(name);
+    EXPECT_TRUE(base::WriteFile(path, contents));
+    return path;
+  }
+
+  std::string GetImage(NTPImageCache* cache, const base::FilePath& path) {
+    std::string result;
+    base::RunLoop run_loop;
+    cache->GetImage(path, base::BindLambdaForTesting(
+                              [&](scoped_refptr<base::RefCountedMemory> bytes) {
+                                if (bytes) {
+                                  result.assign(bytes->front_as<char>(),
+                                                bytes->size());
+                                }
+                                run_loop.Quit();
+                              }));
+    run_loop.Run();
+    return result;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(NTPImageCacheTest, ServesCachedImageWithoutDisk) {
+  NTPImageCache cache(1024);
+  const base::FilePath image = WriteImage("image.jpg", "image data");
+  EXPECT_EQ("image data", GetImage(&cache, image));
+  EXPECT_TRUE(cache.Contains(image));
+
+  // Once cached, the file isn't read again.
+  ASSERT_TRUE(base::DeleteFile(image));
+  EXPECT_EQ("image data", GetImage(&cache, image));
+
+  // Missing files are reported with an empty result and not cached.
+  const base::FilePath missing = temp_dir_.GetPath().AppendASCII("missing");
+  EXPECT_EQ("", GetImage(&cache, missing));
+  EXPECT_FALSE(cache.Contains(missing));
+}
+
+TEST_F(NTPImageCacheTest, WarmReadsImageAhead) {
+  NTPImageCache cache(1024);
+  const base::FilePath image = WriteImage("image.jpg", "image data");
+  cache.Warm(image);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(cache.Contains(image));
+  EXPECT_EQ(10u, cache.size_in_bytes());
+}
+
+TEST_F(NTPImageCacheTest, EvictsLeastRecentlyUsedImages) {
+  NTPImageCache cache(10);
+  const base::FilePath first = WriteImage("first.jpg", "12345");
+  const base::FilePath second = WriteImage("second.jpg", "12345");
+  const base::FilePath third = WriteImage("third.jpg", "12345");
+  const base::FilePath too_big = WriteImage("big.jpg", "12345678901");
+
+  GetImage(&cache, first);
+  GetImage(&cache, second);
+  // Using |first| makes |second| the least recently used image.
+  GetImage(&cache, first);
+  GetImage(&cache, third);
+  EXPECT_TRUE(cache.Contains(first));
+  EXPECT_FALSE(cache.Contains(second));
+  EXPECT_TRUE(cache.Contains(third));
+  EXPECT_EQ(10u, cache.size_in_bytes());
+
+  // Images larger than the whole cache are served but never cached.
+  EXPECT_EQ("12345678901", GetImage(&cache, too_big));
+  EXPECT_FALSE(cache.Contains(too_big));
+  EXPECT_TRUE(cache.Contains(first));
+}
+
+TEST_F(NTPImageCacheTest, ClearsOnMemoryPressure) {
+  NTPImageCache cache(1024);
+  const base::FilePath image = WriteImage("image.jpg", "image data");
+  GetImage(&cache, image);
+  ASSERT_TRUE(cache.Contains(image));
+
+  base::MemoryPressureListener::SimulatePressureNotification(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  task_environment_.RunUntilIdle();
+  EXPECT_FALSE(cache.Contains(image));
+  EXPECT_EQ(0u, cache.size_in_bytes());
+}
+
+}  // namespace ntp_background_images
@@ -16,6 +16,7 @@
 #include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "bat/ads/public/interfaces/ads.mojom.h"
 #include "brave/components/brave_ads/browser/ads_service.h"
 #include "brave/components/brave_ads/common/pref_names.h"
@@ -23,6 +24,7 @@
 #include "brave/components/brave_rewards/common/pref_names.h"
 #include "brave/components/ntp_background_images/browser/features.h"
 #include "brave/components/ntp_background_images/browser/ntp_background_images_data.h"
+#include "brave/components/ntp_background_images/browser/ntp_image_cache.h"
 #include "brave/components/ntp_background_images/browser/ntp_p3a_helper.h"
 #include "brave/components/ntp_background_images/browser/ntp_sponsored_images_data.h"
 #include "brave/components/ntp_background_images/browser/url_constants.h"
@@ -89,6 +91,11 @@ ViewCounterService::ViewCounterService(
       std::make_unique<WeeklyStorage>(local_state, kNewTabsCreated);
   branded_new_tab_count_state_ =
       std::make_unique<WeeklyStorage>(local_state, kSponsoredNewTabsCreated);
+  // Updated on every new tab, so batch the local state writes.
+  new_tab_count_state_->EnableDeferredSaves(
+      base::SequencedTaskRunnerHandle::Get());
+  branded_new_tab_count_state_->EnableDeferredSaves(
+      base::SequencedTaskRunnerHandle::Get());
 
   ResetModel();
 
@@ -306,6 +313,40 @@ void ViewCounterService::ResetModel() {
   if (auto* data = GetCurrentWallpaperData()) {
     model_.set_total_image_count(data->backgrounds.size());
   }
+
+  WarmImageCache();
+}
+
+void ViewCounterService::WarmImageCache() {
+  // Read the images the next NTP is going to show now, so that it can paint
+  // its background without waiting on the disk.
+  NTPImageCache* image_cache = service_->image_cache();
+  if (ShouldShowBrandedWallpaper()) {
+    if (auto* data = GetCurrentBrandedWallpaperData()) {
+      size_t campaign_index;
+      size_t background_index;
+      std::tie(campaign_index, background_index) =
+          model_.GetCurrentBrandedImageIndex();
+      if (campaign_index < data->campaigns.size() &&
+          background_index <
+              data->campaigns[campaign_index].backgrounds.size()) {
+        const auto& background =
+            data->campaigns[campaign_index].backgrounds[background_index];
+        image_cache->Warm(background.image_file);
+        image_cache->Warm(background.logo.image_file);
+      }
+    }
+  }
+
+  // The background wallpaper is also shown when the branded one turns out to
+  // be frequency capped.
+  if (!IsBackgroundWallpaperActive())
+    return;
+  if (auto* data = GetCurrentWallpaperData()) {
+    const size_t index = model_.current_wallpaper_image_index();
+    if (index < data->backgrounds.size())
+      image_cache->Warm(data->backgrounds[index].image_file);
+  }
 }
 
 void ViewCounterService::OnPreferenceChanged(const std::string& pref_name) {
@@ -332,6 +373,7 @@ void ViewCounterService::RegisterPageView() {
   service_->CheckNTPSIComponentUpdateIfNeeded();
   model_.RegisterPageView();
   MaybePrefetchNewTabPageAd();
+  WarmImageCache();
 }
 
 void ViewCounterService::BrandedWallpaperLogoClicked(
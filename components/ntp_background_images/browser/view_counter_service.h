@@ -154,6 +154,7 @@ class ViewCounterService : public KeyedService,
   bool ShouldShowCustomBackground() const;
 
   void ResetModel();
+  void WarmImageCache();
 
   void MaybePrefetchNewTabPageAd();
 
@@ -5,6 +5,7 @@
 
 #include "brave/components/p3a/brave_p3a_log_store.h"
 
+#include <utility>
 #include <vector>
 
 #include "base/check_op.h"
@@ -78,19 +79,26 @@ void BraveP3ALogStore::RegisterPrefs(PrefRegistrySimple* registry) {
 
 void BraveP3ALogStore::UpdateValue(const std::string& histogram_name,
                                    uint64_t value) {
-  LogEntry& entry = log_[histogram_name];
-  entry.value = value;
-
-  if (!entry.sent) {
-    DCHECK(entry.sent_timestamp.is_null());
-    unsent_entries_.insert(histogram_name);
-  }
+  UpdateValues({{histogram_name, value}});
+}
 
-  // Update the persistent value.
+void BraveP3ALogStore::UpdateValues(
+    const std::vector<std::pair<std::string, uint64_t>>& values) {
+  // Update the persistent values.
   DictionaryPrefUpdate update(local_state_, GetPrefName(type_));
-  update->SetPath({histogram_name, kLogValueKey},
-                  base::Value(base::NumberToString(value)));
-  update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  for (const auto& [histogram_name, value] : values) {
+    LogEntry& entry = log_[histogram_name];
+    entry.value = value;
+
+    if (!entry.sent) {
+      DCHECK(entry.sent_timestamp.is_null());
+      unsent_entries_.insert(histogram_name);
+    }
+
+    update->SetPath({histogram_name, kLogValueKey},
+                    base::Value(base::NumberToString(value)));
+    update->SetPath({histogram_name, kLogSentKey}, base::Value(entry.sent));
+  }
 }
 
 void BraveP3ALogStore::RemoveValueIfExists(const std::string& histogram_name) {
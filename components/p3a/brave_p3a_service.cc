@@ -77,6 +77,10 @@ constexpr uint64_t kDefaultUploadIntervalSeconds = 60;  // 1 minute.
 
 constexpr base::TimeDelta kPostRotationUploadDelay = base::Seconds(30);
 
+// How long histogram samples are coalesced before they are written to the log
+// stores (and therefore to local state).
+constexpr base::TimeDelta kHistogramFlushDelay = base::Seconds(5);
+
 bool IsSuspendedMetric(base::StringPiece metric_name,
                        uint64_t value_or_bucket) {
   return value_or_bucket == kSuspendedMetricBucket;
@@ -232,6 +236,10 @@ void BraveP3AService::RemoveDynamicMetric(const std::string& histogram_name) {
   }
   dynamic_metric_sample_callbacks_.erase(histogram_name);
   dynamic_metric_log_types_.erase(histogram_name);
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    pending_histogram_values_.erase(histogram_name);
+  }
 
   DictionaryPrefUpdate update(local_state_, kDynamicMetricsDictPref);
   base::Value::Dict& update_dict = update->GetDict();
@@ -288,11 +296,20 @@ void BraveP3AService::Init(
       base::BindRepeating(&BraveP3AService::OnLogUploadComplete, this));
 
   for (MetricLogType log_type : kAllMetricLogTypes) {
-    rotation_timers_[log_type] = std::make_unique<base::WallClockTimer>();
-
     log_stores_[log_type] =
         std::make_unique<BraveP3ALogStore>(this, local_state_, log_type);
     log_stores_[log_type]->LoadPersistedUnsentLogs();
+  }
+
+  // Store values that were recorded between calling constructor and |Init()|.
+  for (const auto& entry : histogram_values_) {
+    HandleHistogramChange(entry.first, entry.second);
+  }
+  histogram_values_ = {};
+  FlushPendingHistogramValues();
+
+  for (MetricLogType log_type : kAllMetricLogTypes) {
+    rotation_timers_[log_type] = std::make_unique<base::WallClockTimer>();
 
     DoRotationAtInitIfNeeded(log_type);
 
@@ -312,12 +329,11 @@ void BraveP3AService::Init(
       UpdateRotationTimer(log_type);
     }
   }
+}
 
-  // Store values that were recorded between calling constructor and |Init()|.
-  for (const auto& entry : histogram_values_) {
-    HandleHistogramChange(std::string(entry.first), entry.second);
-  }
-  histogram_values_ = {};
+void BraveP3AService::OnShutdown() {
+  DCheckCurrentlyOnUIThread();
+  FlushPendingHistogramValues();
 }
 
 std::string BraveP3AService::Serialize(base::StringPiece histogram_name,
@@ -436,6 +452,7 @@ void BraveP3AService::UpdateMessageMeta() {
 }
 
 void BraveP3AService::StartScheduledUpload(MetricLogType log_type) {
+  FlushPendingHistogramValues();
   if (base::Time::Now() - last_rotation_times_[log_type] <
       kPostRotationUploadDelay) {
     // We should delay uploads right after a rotation to give
@@ -485,10 +502,7 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
   // Shortcut for the special values, see |kSuspendedMetricValue|
   // description for details.
   if (IsSuspendedMetric(histogram_name, sample)) {
-    GetUIThreadTaskRunner()->PostTask(
-        FROM_HERE, base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI,
-                                  this, histogram_name, kSuspendedMetricValue,
-                                  kSuspendedMetricBucket));
+    QueueHistogramValue(histogram_name, kSuspendedMetricBucket);
     return;
   }
 
@@ -517,34 +531,79 @@ void BraveP3AService::OnHistogramChanged(const char* histogram_name,
     bucket = DirectEncodingProtocol::Perturb(bucket_count, bucket);
   }
 
-  GetUIThreadTaskRunner()->PostTask(
-      FROM_HERE, base::BindOnce(&BraveP3AService::OnHistogramChangedOnUI, this,
-                                histogram_name, sample, bucket));
+  QueueHistogramValue(histogram_name, bucket);
+}
+
+void BraveP3AService::QueueHistogramValue(const char* histogram_name,
+                                          size_t bucket) {
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    pending_histogram_values_[histogram_name] = bucket;
+    if (histogram_flush_scheduled_) {
+      return;
+    }
+    histogram_flush_scheduled_ = true;
+  }
+  GetUIThreadTaskRunner()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&BraveP3AService::FlushPendingHistogramValues, this),
+      kHistogramFlushDelay);
 }
 
-void BraveP3AService::OnHistogramChangedOnUI(const char* histogram_name,
-                                             base::HistogramBase::Sample sample,
-                                             size_t bucket) {
-  VLOG(2) << "BraveP3AService::OnHistogramChanged: histogram_name = "
-          << histogram_name << " Sample = " << sample << " bucket = " << bucket;
+void BraveP3AService::FlushPendingHistogramValues() {
+  DCheckCurrentlyOnUIThread();
+  base::flat_map<std::string, size_t> values;
+  {
+    base::AutoLock lock(pending_histogram_values_lock_);
+    values.swap(pending_histogram_values_);
+    histogram_flush_scheduled_ = false;
+  }
+  if (values.empty()) {
+    return;
+  }
+
   if (!initialized_) {
     // Will handle it later when ready.
-    histogram_values_[histogram_name] = bucket;
-  } else {
-    HandleHistogramChange(histogram_name, bucket);
+    for (const auto& [histogram_name, bucket] : values) {
+      histogram_values_[histogram_name] = bucket;
+    }
+    return;
+  }
+
+  base::flat_map<MetricLogType, std::vector<std::pair<std::string, uint64_t>>>
+      updates;
+  for (const auto& [histogram_name, bucket] : values) {
+    VLOG(2) << "BraveP3AService::FlushPendingHistogramValues: "
+            << "histogram_name = " << histogram_name << " bucket = " << bucket;
+    if (IsSuspendedMetric(histogram_name, bucket)) {
+      HandleHistogramChange(histogram_name, bucket);
+      continue;
+    }
+    updates[GetLogTypeForHistogram(histogram_name)].emplace_back(
+        histogram_name, bucket);
+  }
+  for (const auto& [log_type, log_updates] : updates) {
+    log_stores_[log_type]->UpdateValues(log_updates);
   }
 }
 
+MetricLogType BraveP3AService::GetLogTypeForHistogram(
+    base::StringPiece histogram_name) const {
+  if (p3a::kCollectedExpressHistograms.contains(histogram_name)) {
+    return MetricLogType::kExpress;
+  }
+  auto dynamic_log_type =
+      dynamic_metric_log_types_.find(std::string(histogram_name));
+  if (dynamic_log_type != dynamic_metric_log_types_.end()) {
+    return dynamic_log_type->second;
+  }
+  return MetricLogType::kTypical;
+}
+
 void BraveP3AService::HandleHistogramChange(base::StringPiece histogram_name,
                                             size_t bucket) {
-  BraveP3ALogStore* log_store = log_stores_[MetricLogType::kTypical].get();
-  std::string histogram_name_str = std::string(histogram_name);
-  if (p3a::kCollectedExpressHistograms.contains(histogram_name) ||
-      (dynamic_metric_log_types_.contains(histogram_name_str) &&
-       dynamic_metric_log_types_[histogram_name_str] ==
-           MetricLogType::kExpress)) {
-    log_store = log_stores_[MetricLogType::kExpress].get();
-  }
+  BraveP3ALogStore* log_store =
+      log_stores_[GetLogTypeForHistogram(histogram_name)].get();
   if (IsSuspendedMetric(histogram_name, bucket)) {
     log_store->RemoveValueIfExists(std::string(histogram_name));
     return;
@@ -596,6 +655,7 @@ void BraveP3AService::DoRotationAtInitIfNeeded(MetricLogType log_type) {
 void BraveP3AService::DoRotation(MetricLogType log_type) {
   VLOG(2) << "BraveP3AService doing \"" << MetricLogTypeToString(log_type)
           << "\" rotation at " << base::Time::Now();
+  FlushPendingHistogramValues();
   log_stores_[log_type]->ResetUploadStamps();
   last_rotation_times_[log_type] = base::Time::Now();
 
@@ -16,6 +16,8 @@
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/statistics_recorder.h"
 #include "base/strings/string_piece_forward.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
 #include "base/timer/wall_clock_timer.h"
 #include "brave/components/p3a/brave_p3a_log_store.h"
 #include "brave/components/p3a/metric_log_type.h"
@@ -76,6 +78,10 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   void Init(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // Writes histogram values still waiting for the batched flush to the log
+  // stores. Called on browser teardown, while local state can still be saved.
+  void OnShutdown();
+
   // BraveP3ALogStore::Delegate
   std::string Serialize(base::StringPiece histogram_name,
                         uint64_t value,
@@ -85,7 +91,8 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
   bool IsActualMetric(base::StringPiece histogram_name) const override;
 
   // Invoked by callbacks registered by our service. Since these callbacks
-  // can fire on any thread, this method reposts everything to UI thread.
+  // can fire on any thread, this method records the latest bucket for the
+  // histogram and schedules a single batched flush on the UI thread.
   void OnHistogramChanged(const char* histogram_name,
                           uint64_t name_hash,
                           base::HistogramBase::Sample sample);
@@ -105,9 +112,14 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
   void StartScheduledUpload(MetricLogType log_type);
 
-  void OnHistogramChangedOnUI(const char* histogram_name,
-                              base::HistogramBase::Sample sample,
-                              size_t bucket);
+  // Records |bucket| as the latest value for |histogram_name|. Only the
+  // first value queued since the last flush posts a task to the UI thread.
+  void QueueHistogramValue(const char* histogram_name, size_t bucket);
+  // Hands all queued values to the log stores in one batch. Also called right
+  // before uploads and rotations so they always see the latest values.
+  void FlushPendingHistogramValues();
+
+  MetricLogType GetLogTypeForHistogram(base::StringPiece histogram_name) const;
 
   // Updates or removes a metric from the log.
   void HandleHistogramChange(base::StringPiece histogram_name, size_t bucket);
@@ -160,7 +172,15 @@ class BraveP3AService : public base::RefCountedThreadSafe<BraveP3AService>,
 
   // Used to store histogram values that are produced between constructing
   // the service and its initialization.
-  base::flat_map<base::StringPiece, size_t> histogram_values_;
+  base::flat_map<std::string, size_t> histogram_values_;
+
+  // Latest buckets recorded on any thread that haven't been handed to the log
+  // stores yet. Constantly firing metrics only overwrite their entry here.
+  base::Lock pending_histogram_values_lock_;
+  base::flat_map<std::string, size_t> pending_histogram_values_
+      GUARDED_BY(pending_histogram_values_lock_);
+  bool histogram_flush_scheduled_ GUARDED_BY(pending_histogram_values_lock_) =
+      false;
 
   std::vector<
       std::unique_ptr<base::StatisticsRecorder::ScopedHistogramSampleObserver>>
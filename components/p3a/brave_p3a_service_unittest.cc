@@ -267,6 +267,46 @@ TEST_F(P3AServiceTest, MetricSentCallback) {
   }
 }
 
+TEST_F(P3AServiceTest, CoalescesHistogramUpdates) {
+  const std::string histogram_name = GetTestHistogramNames(1, 0)[0];
+
+  for (int i = 1; i <= 5; i++) {
+    base::UmaHistogramExactLinear(histogram_name, i, 8);
+    p3a_service_->OnHistogramChanged(histogram_name.c_str(), 0, i);
+  }
+  task_environment_.RunUntilIdle();
+
+  // Nothing is written to local state until the batch is flushed.
+  const base::Value::Dict& logs = local_state_.GetDict("p3a.logs");
+  EXPECT_EQ(logs.Find(histogram_name), nullptr);
+
+  task_environment_.FastForwardBy(base::Seconds(5));
+
+  const std::string* value =
+      local_state_.GetDict("p3a.logs")
+          .FindStringByDottedPath(histogram_name + ".value");
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, "5");
+}
+
+TEST_F(P3AServiceTest, FlushesHistogramUpdatesOnShutdown) {
+  const std::string histogram_name = GetTestHistogramNames(1, 0)[0];
+
+  base::UmaHistogramExactLinear(histogram_name, 3, 8);
+  p3a_service_->OnHistogramChanged(histogram_name.c_str(), 0, 3);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(local_state_.GetDict("p3a.logs").Find(histogram_name), nullptr);
+
+  // The value is written without waiting for the flush delay.
+  p3a_service_->OnShutdown();
+
+  const std::string* value =
+      local_state_.GetDict("p3a.logs")
+          .FindStringByDottedPath(histogram_name + ".value");
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, "3");
+}
+
 TEST_F(P3AServiceTest, ShouldNotSendIfDisabled) {
   std::vector<std::string> test_histograms = GetTestHistogramNames(3, 3);
 
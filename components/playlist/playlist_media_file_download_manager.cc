@@ -18,11 +18,13 @@ namespace playlist {
 PlaylistMediaFileDownloadManager::PlaylistMediaFileDownloadManager(
     content::BrowserContext* context,
     Delegate* delegate,
-    const base::FilePath& base_dir)
-    : base_dir_(base_dir), delegate_(delegate) {
-  // TODO(pilgrim) dynamically set file extensions based on format.
-  media_file_downloader_ = std::make_unique<PlaylistMediaFileDownloader>(
-      this, context, kMediaFileName);
+    const base::FilePath& base_dir,
+    size_t max_concurrent_downloads)
+    : context_(context),
+      base_dir_(base_dir),
+      delegate_(delegate),
+      max_concurrent_downloads_(max_concurrent_downloads) {
+  DCHECK_GT(max_concurrent_downloads_, 0u);
 }
 
 PlaylistMediaFileDownloadManager::~PlaylistMediaFileDownloadManager() = default;
@@ -31,46 +33,50 @@ void PlaylistMediaFileDownloadManager::DownloadMediaFile(
     const PlaylistItemInfo& playlist_item) {
   pending_media_file_creation_jobs_.push(playlist_item);
 
-  // If either media file controller is generating a playlist media file,
-  // delay the next playlist generation. It will be triggered when the current
-  // one is finished.
-  if (!IsCurrentDownloadingInProgress())
-    TryStartingDownloadTask();
+  // If all downloaders are busy, the item will be picked up when one of them
+  // finishes.
+  TryStartingDownloadTask();
 }
 
 void PlaylistMediaFileDownloadManager::CancelDownloadRequest(
     const std::string& id) {
   VLOG(2) << __func__ << " " << id;
 
-  // Cancel if currently downloading item is id.
+  // Cancel if the item is being downloaded.
   // Otherwise, GetNextPlaylistItemTarget() will drop canceled one.
-  if (GetCurrentDownloadingPlaylistItemID() == id) {
-    CancelCurrentDownloadingPlaylistItem();
+  if (downloaders_.contains(id)) {
+    RemoveDownloader(id);
     TryStartingDownloadTask();
-    return;
   }
 }
 
 void PlaylistMediaFileDownloadManager::CancelAllDownloadRequests() {
-  CancelCurrentDownloadingPlaylistItem();
   pending_media_file_creation_jobs_ = {};
+  while (!downloaders_.empty())
+    RemoveDownloader(downloaders_.begin()->first);
 }
 
 void PlaylistMediaFileDownloadManager::TryStartingDownloadTask() {
-  if (IsCurrentDownloadingInProgress())
-    return;
-
-  if (pending_media_file_creation_jobs_.empty())
-    return;
-
-  current_item_ = GetNextPlaylistItemTarget();
-  if (!current_item_)
-    return;
-
-  VLOG(2) << __func__ << ": " << current_item_->title;
-
-  media_file_downloader_->DownloadMediaFileForPlaylistItem(*current_item_,
-                                                           base_dir_);
+  while (downloaders_.size() < max_concurrent_downloads_ &&
+         !pending_media_file_creation_jobs_.empty()) {
+    auto item = GetNextPlaylistItemTarget();
+    if (!item)
+      return;
+
+    // Already being downloaded.
+    if (downloaders_.contains(item->id))
+      continue;
+
+    VLOG(2) << __func__ << ": " << item->title;
+
+    // TODO(pilgrim) dynamically set file extensions based on format.
+    auto* downloader =
+        downloaders_
+            .emplace(item->id, std::make_unique<PlaylistMediaFileDownloader>(
+                                   this, context_, kMediaFileName))
+            .first->second.get();
+    downloader->DownloadMediaFileForPlaylistItem(*item, base_dir_);
+  }
 }
 
 std::unique_ptr<PlaylistItemInfo>
@@ -86,20 +92,18 @@ PlaylistMediaFileDownloadManager::GetNextPlaylistItemTarget() {
   return nullptr;
 }
 
-std::string
-PlaylistMediaFileDownloadManager::GetCurrentDownloadingPlaylistItemID() const {
-  if (IsCurrentDownloadingInProgress())
-    return media_file_downloader_->current_playlist_id();
-
-  return {};
-}
-
-void PlaylistMediaFileDownloadManager::CancelCurrentDownloadingPlaylistItem() {
-  media_file_downloader_->RequestCancelCurrentPlaylistGeneration();
-}
+void PlaylistMediaFileDownloadManager::RemoveDownloader(const std::string& id) {
+  auto it = downloaders_.find(id);
+  if (it == downloaders_.end())
+    return;
 
-bool PlaylistMediaFileDownloadManager::IsCurrentDownloadingInProgress() const {
-  return media_file_downloader_->in_progress();
+  std::unique_ptr<PlaylistMediaFileDownloader> downloader =
+      std::move(it->second);
+  downloaders_.erase(it);
+  if (downloader->in_progress())
+    downloader->RequestCancelCurrentPlaylistGeneration();
+  base::SequencedTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE,
+                                                     std::move(downloader));
 }
 
 void PlaylistMediaFileDownloadManager::OnMediaFileReady(
@@ -109,7 +113,7 @@ void PlaylistMediaFileDownloadManager::OnMediaFileReady(
 
   delegate_->OnMediaFileReady(id, media_file_path);
 
-  current_item_.reset();
+  RemoveDownloader(id);
 
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
@@ -123,7 +127,7 @@ void PlaylistMediaFileDownloadManager::OnMediaFileGenerationFailed(
 
   delegate_->OnMediaFileGenerationFailed(id);
 
-  CancelCurrentDownloadingPlaylistItem();
+  RemoveDownloader(id);
 
   base::SequencedTaskRunnerHandle::Get()->PostTask(
       FROM_HERE,
@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/queue.h"
 #include "brave/components/playlist/playlist_media_file_downloader.h"
 
@@ -23,9 +24,8 @@ class BrowserContext;
 namespace playlist {
 
 // Download youtube playlist item's audio/video media files.
-// This handles one request at once. So, it has pending queue.
-// And PlaylistMediaFileDownloader does file download task.
-// TODO(simonhong): Download multiple media files simultaneously.
+// Up to |max_concurrent_downloads| items are downloaded at once, each by its
+// own PlaylistMediaFileDownloader. The rest wait in a pending queue.
 class PlaylistMediaFileDownloadManager
     : public PlaylistMediaFileDownloader::Delegate {
  public:
@@ -42,10 +42,13 @@ class PlaylistMediaFileDownloadManager
 
   static constexpr base::FilePath::CharType kMediaFileName[] =
       FILE_PATH_LITERAL("media_file.mp4");
+  static constexpr size_t kDefaultMaxConcurrentDownloads = 3;
 
-  PlaylistMediaFileDownloadManager(content::BrowserContext* context,
-                                   Delegate* delegate,
-                                   const base::FilePath& base_dir);
+  PlaylistMediaFileDownloadManager(
+      content::BrowserContext* context,
+      Delegate* delegate,
+      const base::FilePath& base_dir,
+      size_t max_concurrent_downloads = kDefaultMaxConcurrentDownloads);
   ~PlaylistMediaFileDownloadManager() override;
 
   PlaylistMediaFileDownloadManager(const PlaylistMediaFileDownloadManager&) =
@@ -65,17 +68,20 @@ class PlaylistMediaFileDownloadManager
 
   void TryStartingDownloadTask();
   std::unique_ptr<PlaylistItemInfo> GetNextPlaylistItemTarget();
-  std::string GetCurrentDownloadingPlaylistItemID() const;
-  void CancelCurrentDownloadingPlaylistItem();
-  bool IsCurrentDownloadingInProgress() const;
+  // Cancels and releases the downloader working on |id|, if any. The
+  // downloader is deleted asynchronously as this can be reached from its own
+  // delegate callbacks.
+  void RemoveDownloader(const std::string& id);
 
+  raw_ptr<content::BrowserContext> context_;
   const base::FilePath base_dir_;
   raw_ptr<Delegate> delegate_;
+  const size_t max_concurrent_downloads_;
   base::queue<PlaylistItemInfo> pending_media_file_creation_jobs_;
 
-  std::unique_ptr<PlaylistItemInfo> current_item_;
-
-  std::unique_ptr<PlaylistMediaFileDownloader> media_file_downloader_;
+  // In-flight downloads, keyed by playlist item id.
+  base::flat_map<std::string, std::unique_ptr<PlaylistMediaFileDownloader>>
+      downloaders_;
 
   base::WeakPtrFactory<PlaylistMediaFileDownloadManager> weak_factory_{this};
 };
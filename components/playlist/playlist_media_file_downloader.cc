@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/files/file.h"
@@ -14,17 +15,25 @@
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/task_runner_util.h"
 #include "base/task/thread_pool.h"
-#include "brave/components/api_request_helper/api_request_helper.h"
 #include "brave/components/playlist/playlist_constants.h"
 #include "brave/components/playlist/playlist_types.h"
 #include "build/build_config.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/storage_partition.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
+#include "net/http/http_byte_range.h"
+#include "net/http/http_request_headers.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_status_code.h"
 #include "services/network/public/cpp/resource_request.h"
 #include "services/network/public/cpp/shared_url_loader_factory.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
 #include "url/gurl.h"
 
 namespace playlist {
@@ -47,6 +56,135 @@ net::NetworkTrafficAnnotationTag GetNetworkTrafficAnnotationTagForURLLoad() {
       })");
 }
 
+constexpr base::FilePath::CharType kPartialFileExtension[] =
+    FILE_PATH_LITERAL(".partial");
+constexpr base::FilePath::CharType kRangeFileExtension[] =
+    FILE_PATH_LITERAL(".range");
+constexpr base::FilePath::CharType kValidatorFileExtension[] =
+    FILE_PATH_LITERAL(".validator");
+constexpr int kRetriesCountOnNetworkChange = 1;
+constexpr size_t kCopyBufferSize = 64 * 1024;
+
+base::FilePath GetValidatorFilePath(const base::FilePath& partial_path) {
+  return partial_path.AddExtension(kValidatorFileExtension);
+}
+
+void DeletePartialFile(const base::FilePath& partial_path) {
+  base::DeleteFile(partial_path);
+  base::DeleteFile(GetValidatorFilePath(partial_path));
+}
+
+// Returns a strong ETag, or else the Last-Modified date, of a response. Either
+// can be sent back in If-Range so that a resumed range is only served if the
+// remote file hasn't changed since the partial file was started.
+std::string GetValidator(const net::HttpResponseHeaders& headers) {
+  std::string etag;
+  if (headers.EnumerateHeader(nullptr, "ETag", &etag) && !etag.empty() &&
+      !base::StartsWith(etag, "W/")) {
+    return etag;
+  }
+  std::string last_modified;
+  headers.EnumerateHeader(nullptr, "Last-Modified", &last_modified);
+  return last_modified;
+}
+
+// A partial file is only resumed with the validator of the response that
+// started it. Without one there is no way to tell whether the remote file
+// changed, so it is discarded.
+PlaylistMediaFileDownloader::PartialFileInfo GetPartialFileInfo(
+    const base::FilePath& partial_path) {
+  PlaylistMediaFileDownloader::PartialFileInfo info;
+  if (!base::GetFileSize(partial_path, &info.size) || info.size <= 0)
+    return {};
+  if (!base::ReadFileToString(GetValidatorFilePath(partial_path),
+                              &info.validator) ||
+      info.validator.empty()) {
+    DeletePartialFile(partial_path);
+    return {};
+  }
+  return info;
+}
+
+bool AppendFileContents(const base::FilePath& source,
+                        const base::FilePath& target) {
+  base::File in(source, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  base::File out(target, base::File::FLAG_OPEN | base::File::FLAG_APPEND);
+  if (!in.IsValid() || !out.IsValid())
+    return false;
+
+  std::vector<char> buffer(kCopyBufferSize);
+  while (true) {
+    const int read = in.ReadAtCurrentPos(buffer.data(), buffer.size());
+    if (read < 0)
+      return false;
+    if (read == 0)
+      return true;
+    if (out.WriteAtCurrentPos(buffer.data(), read) != read)
+      return false;
+  }
+}
+
+// Folds the body received by the last request into |partial_path| and, if
+// the whole body has arrived, moves it to |media_path|. Returns true when
+// |media_path| is complete. |stored_validator| is the one the request was
+// resumed with, if any.
+bool FinalizeMediaFile(const base::FilePath& media_path,
+                       const base::FilePath& partial_path,
+                       const base::FilePath& downloaded_path,
+                       int64_t offset,
+                       int response_code,
+                       int net_error,
+                       const std::string& validator,
+                       const std::string& stored_validator) {
+  // No headers means the server never answered, which says nothing about
+  // whether the partial file is still valid.
+  const bool has_response = response_code > 0;
+  if (offset > 0 && !downloaded_path.empty()) {
+    bool merged = !has_response;
+    if (response_code == net::HTTP_PARTIAL_CONTENT) {
+      merged = AppendFileContents(downloaded_path, partial_path);
+    } else if (response_code == net::HTTP_OK) {
+      // Server ignored the Range header and sent the whole body.
+      merged = base::ReplaceFile(downloaded_path, partial_path, nullptr);
+    }
+    base::DeleteFile(downloaded_path);
+    if (!merged) {
+      DeletePartialFile(partial_path);
+      return false;
+    }
+  }
+
+  if (net_error != net::OK) {
+    // Keep what we have so the next attempt can resume from there, unless
+    // the server rejected the request itself or it can't be validated. A 206
+    // matched If-Range, so like no answer at all it leaves the stored
+    // validator in force.
+    const std::string& resume_validator =
+        !has_response || (response_code == net::HTTP_PARTIAL_CONTENT &&
+                          validator.empty())
+            ? stored_validator
+            : validator;
+    if (response_code >= 400 || resume_validator.empty() ||
+        !base::WriteFile(GetValidatorFilePath(partial_path),
+                         resume_validator)) {
+      DeletePartialFile(partial_path);
+    }
+    return false;
+  }
+
+  base::DeleteFile(GetValidatorFilePath(partial_path));
+  return base::ReplaceFile(partial_path, media_path, nullptr);
+}
+
+// Drops a partial file which can't be resumed, along with whatever the last
+// request downloaded.
+void DiscardPartialFile(const base::FilePath& partial_path,
+                        const base::FilePath& downloaded_path) {
+  DeletePartialFile(partial_path);
+  if (!downloaded_path.empty())
+    base::DeleteFile(downloaded_path);
+}
+
 }  // namespace
 
 PlaylistMediaFileDownloader::PlaylistMediaFileDownloader(
@@ -57,9 +195,6 @@ PlaylistMediaFileDownloader::PlaylistMediaFileDownloader(
       url_loader_factory_(
           context->content::BrowserContext::GetDefaultStoragePartition()
               ->GetURLLoaderFactoryForBrowserProcess()),
-      request_helper_(std::make_unique<api_request_helper::APIRequestHelper>(
-          GetNetworkTrafficAnnotationTagForURLLoad(),
-          url_loader_factory_)),
       media_file_name_(media_file_name) {}
 
 PlaylistMediaFileDownloader::~PlaylistMediaFileDownloader() = default;
@@ -108,29 +243,126 @@ void PlaylistMediaFileDownloader::DownloadMediaFile(const GURL& url,
                                                     int index) {
   VLOG(2) << __func__ << ": " << url.spec() << " at: " << index;
 
-  const base::FilePath file_path = playlist_dir_path_.Append(media_file_name_);
-  request_helper_->Download(
-      url, {}, {}, true, file_path,
+  // Check how much of the file an earlier, interrupted attempt left behind.
+  task_runner()->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&GetPartialFileInfo, GetPartialMediaFilePath()),
+      base::BindOnce(&PlaylistMediaFileDownloader::OnPartialFileChecked,
+                     weak_factory_.GetWeakPtr(), url, index));
+}
+
+void PlaylistMediaFileDownloader::OnPartialFileChecked(
+    const GURL& url,
+    int index,
+    const PartialFileInfo& partial_file) {
+  const int64_t offset = partial_file.size;
+  auto request = std::make_unique<network::ResourceRequest>();
+  request->url = url;
+  request->load_flags = net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE |
+                        net::LOAD_DO_NOT_SAVE_COOKIES;
+  request->credentials_mode = network::mojom::CredentialsMode::kOmit;
+  if (offset > 0) {
+    VLOG(2) << __func__ << ": resuming download from " << offset;
+    request->headers.SetHeader(
+        net::HttpRequestHeaders::kRange,
+        net::HttpByteRange::RightUnbounded(offset).GetHeaderValue());
+    // The server sends the whole file instead if it changed since.
+    request->headers.SetHeader(net::HttpRequestHeaders::kIfRange,
+                               partial_file.validator);
+  }
+
+  url_loader_ = network::SimpleURLLoader::Create(
+      std::move(request), GetNetworkTrafficAnnotationTagForURLLoad());
+  url_loader_->SetRetryOptions(
+      kRetriesCountOnNetworkChange,
+      network::SimpleURLLoader::RetryMode::RETRY_ON_NETWORK_CHANGE);
+  // Keep whatever was received if the transfer fails midway so that it can
+  // be resumed later.
+  url_loader_->SetAllowPartialResults(true);
+
+  const base::FilePath target_path =
+      offset > 0 ? GetPartialMediaFilePath().AddExtension(kRangeFileExtension)
+                 : GetPartialMediaFilePath();
+  url_loader_->DownloadToFile(
+      url_loader_factory_.get(),
       base::BindOnce(&PlaylistMediaFileDownloader::OnMediaFileDownloaded,
-                     base::Unretained(this), index));
+                     weak_factory_.GetWeakPtr(), url, index, offset,
+                     partial_file.validator),
+      target_path);
 }
 
-void PlaylistMediaFileDownloader::OnMediaFileDownloaded(int index,
-                                                        base::FilePath path) {
+void PlaylistMediaFileDownloader::OnMediaFileDownloaded(
+    const GURL& url,
+    int index,
+    int64_t offset,
+    const std::string& stored_validator,
+    base::FilePath path) {
   VLOG(2) << __func__ << ": downloaded media file at " << path;
 
   DCHECK(current_item_);
+  DCHECK(url_loader_);
+
+  int response_code = -1;
+  std::string validator;
+  bool range_matches = true;
+  if (url_loader_->ResponseInfo() && url_loader_->ResponseInfo()->headers) {
+    const auto& headers = *url_loader_->ResponseInfo()->headers;
+    response_code = headers.response_code();
+    validator = GetValidator(headers);
+    if (offset > 0 && response_code == net::HTTP_PARTIAL_CONTENT) {
+      int64_t first_byte = -1;
+      int64_t last_byte = -1;
+      int64_t length = -1;
+      range_matches =
+          headers.GetContentRangeFor206(&first_byte, &last_byte, &length) &&
+          first_byte == offset;
+    }
+  }
+  const int net_error = url_loader_->NetError();
+  VLOG(2) << __func__ << ": received " << url_loader_->GetContentSize()
+          << " bytes, response: " << response_code
+          << " error: " << net::ErrorToString(net_error);
+  url_loader_.reset();
+
+  if (!range_matches) {
+    // Appending a range which doesn't start where the partial file ends
+    // would corrupt it, so start over from the beginning.
+    VLOG(1) << __func__ << ": unexpected Content-Range, restarting download";
+    task_runner()->PostTaskAndReply(
+        FROM_HERE,
+        base::BindOnce(&DiscardPartialFile, GetPartialMediaFilePath(), path),
+        base::BindOnce(&PlaylistMediaFileDownloader::DownloadMediaFile,
+                       weak_factory_.GetWeakPtr(), url, index));
+    return;
+  }
+
+  task_runner()->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&FinalizeMediaFile, GetMediaFilePath(),
+                     GetPartialMediaFilePath(), path, offset, response_code,
+                     net_error, validator, stored_validator),
+      base::BindOnce(&PlaylistMediaFileDownloader::OnMediaFileFinalized,
+                     weak_factory_.GetWeakPtr(), index));
+}
+
+void PlaylistMediaFileDownloader::OnMediaFileFinalized(int index,
+                                                       bool success) {
+  DCHECK(current_item_);
 
-  if (path.empty()) {
-    // This fail is handled during the generation.
-    // See |has_skipped_source_files| in DoGenerateSingleMediaFile().
-    // |has_skipped_source_files| will be set to true.
+  if (!success) {
     VLOG(1) << __func__ << ": failed to download media file at " << index;
     NotifyFail(current_item_->id);
     return;
   }
 
-  NotifySucceed(current_item_->id, path.AsUTF8Unsafe());
+  NotifySucceed(current_item_->id, GetMediaFilePath().AsUTF8Unsafe());
+}
+
+base::FilePath PlaylistMediaFileDownloader::GetMediaFilePath() const {
+  return playlist_dir_path_.Append(media_file_name_);
+}
+
+base::FilePath PlaylistMediaFileDownloader::GetPartialMediaFilePath() const {
+  return GetMediaFilePath().AddExtension(kPartialFileExtension);
 }
 
 void PlaylistMediaFileDownloader::RequestCancelCurrentPlaylistGeneration() {
@@ -149,8 +381,10 @@ base::SequencedTaskRunner* PlaylistMediaFileDownloader::task_runner() {
 void PlaylistMediaFileDownloader::ResetDownloadStatus() {
   in_progress_ = false;
   current_item_.reset();
-  request_helper_ = std::make_unique<api_request_helper::APIRequestHelper>(
-      GetNetworkTrafficAnnotationTagForURLLoad(), url_loader_factory_);
+  // Drop the in-flight request and any pending file task replies. A partial
+  // file is left on disk so the download can be resumed.
+  url_loader_.reset();
+  weak_factory_.InvalidateWeakPtrs();
   playlist_dir_path_.clear();
 }
 
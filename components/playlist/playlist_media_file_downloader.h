@@ -16,10 +16,6 @@
 #include "base/values.h"
 #include "brave/components/playlist/playlist_types.h"
 
-namespace api_request_helper {
-class APIRequestHelper;
-}  // namespace api_request_helper
-
 namespace base {
 class FilePath;
 class SequencedTaskRunner;
@@ -39,8 +35,20 @@ class GURL;
 namespace playlist {
 
 // Handle one Playlist at once.
+// The media file is first written to a ".partial" file next to the target
+// path. If a download is interrupted, the bytes received so far are kept,
+// along with the response's ETag or Last-Modified, and the next attempt for
+// the same item only requests the remaining range, if the file is unchanged.
 class PlaylistMediaFileDownloader {
  public:
+  // What an earlier, interrupted attempt left behind.
+  struct PartialFileInfo {
+    int64_t size = 0;
+    // Sent as If-Range when resuming.
+    std::string validator;
+  };
+
+
   class Delegate {
    public:
     // Called when target media file generation succeed.
@@ -73,7 +81,18 @@ class PlaylistMediaFileDownloader {
  private:
   void ResetDownloadStatus();
   void DownloadMediaFile(const GURL& url, int index);
-  void OnMediaFileDownloaded(int index, base::FilePath path);
+  void OnPartialFileChecked(const GURL& url,
+                            int index,
+                            const PartialFileInfo& partial_file);
+  void OnMediaFileDownloaded(const GURL& url,
+                             int index,
+                             int64_t offset,
+                             const std::string& stored_validator,
+                             base::FilePath path);
+  void OnMediaFileFinalized(int index, bool success);
+
+  base::FilePath GetMediaFilePath() const;
+  base::FilePath GetPartialMediaFilePath() const;
 
   void NotifyFail(const std::string& id);
   void NotifySucceed(const std::string& id, const std::string& media_file_path);
@@ -83,7 +102,7 @@ class PlaylistMediaFileDownloader {
   raw_ptr<Delegate> delegate_ = nullptr;
 
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
-  std::unique_ptr<api_request_helper::APIRequestHelper> request_helper_;
+  std::unique_ptr<network::SimpleURLLoader> url_loader_;
 
   const base::FilePath::StringType media_file_name_;
 
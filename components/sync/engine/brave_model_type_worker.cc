@@ -5,12 +5,15 @@
 
 #include "brave/components/sync/engine/brave_model_type_worker.h"
 
+#include <string>
 #include <utility>
 
 #include "base/feature_list.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_functions.h"
+#include "base/trace_event/trace_event.h"
 #include "components/sync/engine/model_type_processor.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace syncer {
 
@@ -32,6 +35,53 @@ namespace {
 size_t kFailuresToResetMarker = 7;
 // Allow reset progress marker for type not often than once in 30 minutes
 base::TimeDelta kMinimalTimeBetweenResetMarker = base::Minutes(30);
+
+// On the 3 failures before the full reset, the progress marker is rewound
+// by 1, 2 and then 4 days, which re-downloads only the recently changed
+// entities, where the conflicting ones are expected to be. The full reset
+// still happens on the 7th failure.
+constexpr size_t kMaxRewinds = 3;
+constexpr base::TimeDelta kInitialRewindWindow = base::Days(1);
+
+// The Brave sync server's progress token is the mtime in milliseconds of the
+// last entity sent, written as a zigzag varint into a zero padded buffer of
+// the maximum varint size (Go's binary.PutVarint).
+constexpr size_t kMaxVarintLength = 10;
+
+constexpr char kTraceCategory[] = "brave";
+
+absl::optional<int64_t> DecodeProgressToken(const std::string& token) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < token.size() && i < kMaxVarintLength; ++i) {
+    const uint8_t byte = static_cast<uint8_t>(token[i]);
+    value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if (byte & 0x80) {
+      continue;
+    }
+    if (token.find_first_not_of('\0', i + 1) != std::string::npos) {
+      return absl::nullopt;
+    }
+    const int64_t decoded = static_cast<int64_t>(value >> 1);
+    return (value & 1) ? ~decoded : decoded;
+  }
+  return absl::nullopt;
+}
+
+std::string EncodeProgressToken(int64_t value) {
+  uint64_t zigzag = static_cast<uint64_t>(value) << 1;
+  if (value < 0) {
+    zigzag = ~zigzag;
+  }
+  std::string token;
+  while (zigzag >= 0x80) {
+    token.push_back(static_cast<char>(zigzag | 0x80));
+    zigzag >>= 7;
+  }
+  token.push_back(static_cast<char>(zigzag));
+  token.resize(kMaxVarintLength, '\0');
+  return token;
+}
+
 }  // namespace
 
 BraveModelTypeWorker::BraveModelTypeWorker(
@@ -62,8 +112,11 @@ void BraveModelTypeWorker::OnCommitResponse(
     return;
   }
 
+  const size_t previous_failed_commit_times = failed_commit_times_;
   if (IsResetProgressMarkerRequired(error_response_list)) {
     ResetProgressMarker();
+  } else if (failed_commit_times_ > previous_failed_commit_times) {
+    RewindProgressMarker();
   }
 }
 
@@ -77,6 +130,22 @@ base::TimeDelta BraveModelTypeWorker::MinimalTimeBetweenResetForTests() {
   return kMinimalTimeBetweenResetMarker;
 }
 
+// static
+size_t BraveModelTypeWorker::GetMaxRewindsForTests() {
+  return kMaxRewinds;
+}
+
+// static
+base::TimeDelta BraveModelTypeWorker::GetInitialRewindWindowForTests() {
+  return kInitialRewindWindow;
+}
+
+// static
+std::string BraveModelTypeWorker::EncodeProgressTokenForTests(
+    int64_t mtime_ms) {
+  return EncodeProgressToken(mtime_ms);
+}
+
 bool BraveModelTypeWorker::IsResetProgressMarkerRequired(
     const FailedCommitResponseDataList& error_response_list) {
   if (!last_reset_marker_time_.is_null() &&
@@ -110,11 +179,42 @@ bool BraveModelTypeWorker::IsResetProgressMarkerRequired(
   return failed_commit_times_ >= kFailuresToResetMarker;
 }
 
+void BraveModelTypeWorker::RewindProgressMarker() {
+  if (failed_commit_times_ + kMaxRewinds < kFailuresToResetMarker) {
+    return;
+  }
+  const size_t rewind =
+      failed_commit_times_ + kMaxRewinds - kFailuresToResetMarker;
+
+  const absl::optional<int64_t> mtime_ms =
+      DecodeProgressToken(model_type_state_.progress_marker().token());
+  if (!mtime_ms) {
+    return;
+  }
+
+  const base::TimeDelta window = kInitialRewindWindow * (1 << rewind);
+  const int64_t rewound_mtime_ms = *mtime_ms - window.InMilliseconds();
+  if (rewound_mtime_ms <= 0) {
+    return;
+  }
+
+  VLOG(1) << "Rewind progress marker for type " << ModelTypeToDebugString(type_)
+          << " by " << window;
+  TRACE_EVENT_INSTANT1(kTraceCategory, "RewindProgressMarker",
+                       TRACE_EVENT_SCOPE_THREAD, "type",
+                       ModelTypeToDebugString(type_));
+  model_type_state_.mutable_progress_marker()->set_token(
+      EncodeProgressToken(rewound_mtime_ms));
+}
+
 void BraveModelTypeWorker::ResetProgressMarker() {
   VLOG(1) << "Reset progress marker for type " << ModelTypeToDebugString(type_);
   // Normal reset of progress marker due to 7th failure
   // P3A sample is 0
   base::UmaHistogramExactLinear("Brave.Sync.ProgressTokenEverReset", 0, 1);
+  TRACE_EVENT_INSTANT1(kTraceCategory, "ResetProgressMarker",
+                       TRACE_EVENT_SCOPE_THREAD, "type",
+                       ModelTypeToDebugString(type_));
   last_reset_marker_time_ = base::Time::Now();
   model_type_state_.mutable_progress_marker()->clear_token();
 }
@@ -7,6 +7,7 @@
 #define BRAVE_COMPONENTS_SYNC_ENGINE_BRAVE_MODEL_TYPE_WORKER_H_
 
 #include <memory>
+#include <string>
 
 #include "base/feature_list.h"
 #include "components/sync/base/model_type.h"
@@ -31,6 +32,9 @@ FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, ResetProgressMarker);
 FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, ResetProgressMarkerMaxPeriod);
 FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
                      ResetProgressMarkerDisabledFeature);
+FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest, RewindProgressMarker);
+FORWARD_DECLARE_TEST(BraveModelTypeWorkerTest,
+                     RewindProgressMarkerCountResetsAfterSuccess);
 
 class BraveModelTypeWorker : public ModelTypeWorker {
  public:
@@ -51,6 +55,9 @@ class BraveModelTypeWorker : public ModelTypeWorker {
                            ResetProgressMarkerMaxPeriod);
   FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
                            ResetProgressMarkerDisabledFeature);
+  FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest, RewindProgressMarker);
+  FRIEND_TEST_ALL_PREFIXES(BraveModelTypeWorkerTest,
+                           RewindProgressMarkerCountResetsAfterSuccess);
 
   void OnCommitResponse(
       const CommitResponseDataList& committed_response_list,
@@ -59,11 +66,19 @@ class BraveModelTypeWorker : public ModelTypeWorker {
   bool IsResetProgressMarkerRequired(
       const FailedCommitResponseDataList& error_response_list);
   void ResetProgressMarker();
+  // On the failures just before the full reset, moves the progress marker
+  // back by a window that doubles with every failure, so that the next
+  // GetUpdates re-downloads only the entities changed within it. Leaves the
+  // marker untouched if the token can't be rewound.
+  void RewindProgressMarker();
 
   size_t failed_commit_times_ = 0;
   base::Time last_reset_marker_time_;
   static size_t GetFailuresToResetMarkerForTests();
   static base::TimeDelta MinimalTimeBetweenResetForTests();
+  static size_t GetMaxRewindsForTests();
+  static base::TimeDelta GetInitialRewindWindowForTests();
+  static std::string EncodeProgressTokenForTests(int64_t mtime_ms);
 };
 
 }  // namespace syncer
@@ -5,6 +5,7 @@
 
 #include "brave/components/sync/engine/brave_model_type_worker.h"
 
+#include <string>
 #include <utility>
 
 #include "base/bind.h"
@@ -81,6 +82,14 @@ class BraveModelTypeWorkerTest : public ::testing::Test {
     worker()->model_type_state_.mutable_progress_marker()->set_token("TOKEN1");
   }
 
+  void SetProgressMarkerToken(const std::string& token) {
+    worker()->model_type_state_.mutable_progress_marker()->set_token(token);
+  }
+
+  const std::string& GetProgressMarkerToken() {
+    return worker()->model_type_state_.progress_marker().token();
+  }
+
  private:
   base::test::SingleThreadTaskEnvironment task_environment;
   const ModelType model_type_;
@@ -213,4 +222,69 @@ TEST_F(BraveModelTypeWorkerTest, ResetProgressMarkerDisabledFeature) {
   EXPECT_FALSE(IsProgressMarkerEmpty());
 }
 
+TEST_F(BraveModelTypeWorkerTest, RewindProgressMarker) {
+  NormalInitialize();
+  const int64_t kMtimeMs = 1666000000000;
+  SetProgressMarkerToken(
+      BraveModelTypeWorker::EncodeProgressTokenForTests(kMtimeMs));
+  auto error_response_list =
+      MakeErrorResponseList(CommitResponse_ResponseType_CONFLICT);
+
+  const size_t failures_to_reset =
+      BraveModelTypeWorker::GetFailuresToResetMarkerForTests();
+  const size_t max_rewinds = BraveModelTypeWorker::GetMaxRewindsForTests();
+  for (size_t i = 0; i < failures_to_reset - max_rewinds - 1; ++i) {
+    worker()->OnCommitResponse(CommitResponseDataList(), error_response_list);
+    EXPECT_EQ(BraveModelTypeWorker::EncodeProgressTokenForTests(kMtimeMs),
+              GetProgressMarkerToken());
+  }
+
+  // The failures just before the reset move the marker back by a window
+  // which doubles every time
+  int64_t expected_mtime_ms = kMtimeMs;
+  base::TimeDelta window =
+      BraveModelTypeWorker::GetInitialRewindWindowForTests();
+  for (size_t rewind = 0; rewind < max_rewinds; ++rewind) {
+    worker()->OnCommitResponse(CommitResponseDataList(), error_response_list);
+    expected_mtime_ms -= window.InMilliseconds();
+    EXPECT_EQ(
+        BraveModelTypeWorker::EncodeProgressTokenForTests(expected_mtime_ms),
+        GetProgressMarkerToken());
+    window *= 2;
+  }
+
+  // The full reset still happens on the same failure as without rewinds
+  worker()->OnCommitResponse(CommitResponseDataList(), error_response_list);
+  EXPECT_TRUE(IsProgressMarkerEmpty());
+}
+
+TEST_F(BraveModelTypeWorkerTest, RewindProgressMarkerCountResetsAfterSuccess) {
+  NormalInitialize();
+  const int64_t kMtimeMs = 1666000000000;
+  const std::string token =
+      BraveModelTypeWorker::EncodeProgressTokenForTests(kMtimeMs);
+  const std::string rewound_token =
+      BraveModelTypeWorker::EncodeProgressTokenForTests(
+          kMtimeMs - BraveModelTypeWorker::GetInitialRewindWindowForTests()
+                         .InMilliseconds());
+  auto error_response_list =
+      MakeErrorResponseList(CommitResponse_ResponseType_TRANSIENT_ERROR);
+
+  const size_t failures_to_first_rewind =
+      BraveModelTypeWorker::GetFailuresToResetMarkerForTests() -
+      BraveModelTypeWorker::GetMaxRewindsForTests();
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    SetProgressMarkerToken(token);
+    for (size_t i = 0; i < failures_to_first_rewind; ++i) {
+      worker()->OnCommitResponse(CommitResponseDataList(), error_response_list);
+    }
+    EXPECT_EQ(rewound_token, GetProgressMarkerToken());
+
+    // The narrowed re-download resolved the failures, so the next ones
+    // start again from the smallest window
+    worker()->OnCommitResponse(CommitResponseDataList(),
+                               FailedCommitResponseDataList());
+  }
+}
+
 }  // namespace syncer
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "base/ranges/algorithm.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
@@ -41,12 +42,14 @@ TimePeriodStorage::TimePeriodStorage(PrefService* prefs,
   Load();
 }
 
-TimePeriodStorage::~TimePeriodStorage() = default;
+TimePeriodStorage::~TimePeriodStorage() {
+  Flush();
+}
 
 void TimePeriodStorage::AddDelta(uint64_t delta) {
   FilterToPeriod();
   daily_values_.front().value += delta;
-  Save();
+  ScheduleSave();
 }
 
 void TimePeriodStorage::SubDelta(uint64_t delta) {
@@ -59,7 +62,7 @@ void TimePeriodStorage::SubDelta(uint64_t delta) {
     daily_value.value -= day_delta;
     delta -= day_delta;
   }
-  Save();
+  ScheduleSave();
 }
 
 void TimePeriodStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
@@ -68,14 +71,14 @@ void TimePeriodStorage::ReplaceTodaysValueIfGreater(uint64_t value) {
   if (today.value < value) {
     today.value = value;
   }
-  Save();
+  ScheduleSave();
 }
 
 void TimePeriodStorage::ReplaceIfGreaterForDate(const base::Time& date,
                                                 uint64_t value) {
   FilterToPeriod();
   base::Time date_mn = date.LocalMidnight();
-  std::list<DailyValue>::iterator day_insert_it = base::ranges::find_if(
+  auto day_insert_it = base::ranges::find_if(
       daily_values_,
       [date_mn](const DailyValue& val) { return val.day <= date_mn; });
   if (day_insert_it != daily_values_.end() && day_insert_it->day == date_mn) {
@@ -86,7 +89,7 @@ void TimePeriodStorage::ReplaceIfGreaterForDate(const base::Time& date,
   } else {
     daily_values_.insert(day_insert_it, {date_mn, value});
   }
-  Save();
+  ScheduleSave();
 }
 
 uint64_t TimePeriodStorage::GetPeriodSum() const {
@@ -106,23 +109,13 @@ uint64_t TimePeriodStorage::GetPeriodSum() const {
 uint64_t TimePeriodStorage::GetHighestValueInPeriod() const {
   // We record only value for last N days.
   const base::Time n_days_ago = clock_->Now() - base::Days(period_days_);
-  std::list<DailyValue> in_period_daily_values(daily_values_.size());
-  auto copied_it =
-      std::copy_if(daily_values_.begin(), daily_values_.end(),
-                   in_period_daily_values.begin(),
-                   [n_days_ago](auto i) { return i.day > n_days_ago; });
-  in_period_daily_values.resize(
-      std::distance(in_period_daily_values.begin(), copied_it));
-
-  auto highest_it = std::max_element(in_period_daily_values.begin(),
-                                     in_period_daily_values.end(),
-                                     [](const auto& left, const auto& right) {
-                                       return left.value < right.value;
-                                     });
-  if (highest_it == in_period_daily_values.end()) {
-    return 0;
+  uint64_t highest = 0;
+  for (const DailyValue& daily_value : daily_values_) {
+    if (daily_value.day > n_days_ago) {
+      highest = std::max(highest, daily_value.value);
+    }
   }
-  return highest_it->value;
+  return highest;
 }
 
 bool TimePeriodStorage::IsOnePeriodPassed() const {
@@ -168,13 +161,39 @@ void TimePeriodStorage::Load() {
   }
 }
 
+void TimePeriodStorage::EnableDeferredSaves(
+    scoped_refptr<base::SequencedTaskRunner> task_runner) {
+  DCHECK(!save_timer_.IsRunning());
+  defer_saves_ = true;
+  save_timer_.SetTaskRunner(std::move(task_runner));
+}
+
+void TimePeriodStorage::Flush() {
+  save_timer_.Stop();
+  if (dirty_) {
+    Save();
+  }
+}
+
+void TimePeriodStorage::ScheduleSave() {
+  dirty_ = true;
+  if (!defer_saves_) {
+    Save();
+    return;
+  }
+  // Not restarted on further mutations, so a steady stream of updates is
+  // still written out at least every |kSaveDelay|.
+  if (!save_timer_.IsRunning()) {
+    save_timer_.Start(FROM_HERE, kSaveDelay, this, &TimePeriodStorage::Flush);
+  }
+}
+
 void TimePeriodStorage::Save() {
   DCHECK(!daily_values_.empty());
   DCHECK_LE(daily_values_.size(), period_days_);
+  dirty_ = false;
 
   base::Value::List list;
-  // TODO(iefremov): Optimize if needed.
-  list.clear();
   for (const auto& u : daily_values_) {
     base::Value::Dict value;
     value.Set("day", u.day.ToDoubleT());
@@ -6,20 +6,29 @@
 #ifndef BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_TIME_PERIOD_STORAGE_H_
 #define BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_TIME_PERIOD_STORAGE_H_
 
-#include <list>
 #include <memory>
 
+#include "base/containers/circular_deque.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 
 namespace base {
 class Clock;
-}
+class SequencedTaskRunner;
+}  // namespace base
 
 class PrefService;
 
 // Mostly used by various P3A recorders - allows to track a sum of some
 // values added from time to time via |AddDelta| over the last predefined time
 // period. Requires |pref_name| to be already registered.
+//
+// Values are kept in memory as a ring of at most |period_days| day buckets.
+// By default every mutation is saved to prefs right away. Long-lived storages
+// holding frequently updated counters can call |EnableDeferredSaves|, after
+// which mutations only mark the storage dirty and the pref is written at most
+// once per |kSaveDelay|, on |Flush| and on destruction.
 class TimePeriodStorage {
  public:
   TimePeriodStorage(PrefService* prefs,
@@ -44,6 +53,16 @@ class TimePeriodStorage {
   uint64_t GetHighestValueInPeriod() const;
   bool IsOnePeriodPassed() const;
 
+  // Defers pref writes to a timer running on |task_runner|. The owner must
+  // destroy or |Flush| the storage before shutdown to keep the last changes.
+  void EnableDeferredSaves(
+      scoped_refptr<base::SequencedTaskRunner> task_runner);
+
+  // Writes pending changes to prefs right away.
+  void Flush();
+
+  static constexpr base::TimeDelta kSaveDelay = base::Seconds(5);
+
  private:
   struct DailyValue {
     base::Time day;
@@ -52,13 +71,18 @@ class TimePeriodStorage {
   void FilterToPeriod();
   void Load();
   void Save();
+  void ScheduleSave();
 
   PrefService* prefs_ = nullptr;
   const char* pref_name_ = nullptr;
   size_t period_days_;
   std::unique_ptr<base::Clock> clock_;
 
-  std::list<DailyValue> daily_values_;
+  // Most recent day first.
+  base::circular_deque<DailyValue> daily_values_;
+  bool dirty_ = false;
+  bool defer_saves_ = false;
+  base::OneShotTimer save_timer_;
 };
 
 #endif  // BRAVE_COMPONENTS_TIME_PERIOD_STORAGE_TIME_PERIOD_STORAGE_H_
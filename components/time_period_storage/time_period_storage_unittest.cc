@@ -10,6 +10,7 @@
 
 #include "base/memory/raw_ptr.h"
 #include "base/test/simple_test_clock.h"
+#include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/prefs/pref_registry_simple.h"
 #include "components/prefs/testing_pref_service.h"
@@ -240,3 +241,68 @@ TEST_F(TimePeriodStorageTest, ReplaceIfGreaterForDate) {
   state_->ReplaceIfGreaterForDate(clock_->Now() - base::Days(31), 10);
   EXPECT_EQ(state_->GetPeriodSum(), 11U);
 }
+
+TEST_F(TimePeriodStorageTest, SavesImmediatelyByDefault) {
+  InitStorage(7);
+  state_->AddDelta(4);
+  const base::Value::List& list = pref_service_.GetList(kPrefName);
+  ASSERT_EQ(list.size(), 1U);
+  EXPECT_EQ(list[0].GetDict().FindDouble("value"), 4);
+}
+
+class TimePeriodStorageCoalescingTest : public TimePeriodStorageTest {
+ public:
+  void InitStorage(size_t days) {
+    TimePeriodStorageTest::InitStorage(days);
+    state_->EnableDeferredSaves(task_environment_.GetMainThreadTaskRunner());
+  }
+
+  // The storage flushes on destruction, so it has to go away while the task
+  // environment is still alive.
+  void TearDown() override {
+    clock_ = nullptr;
+    state_.reset();
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+};
+
+TEST_F(TimePeriodStorageCoalescingTest, CoalescesWritesUntilDelay) {
+  InitStorage(7);
+  state_->AddDelta(1);
+  state_->AddDelta(2);
+  state_->ReplaceTodaysValueIfGreater(10);
+  EXPECT_EQ(state_->GetPeriodSum(), 10U);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName).empty());
+
+  task_environment_.FastForwardBy(TimePeriodStorage::kSaveDelay);
+  const base::Value::List& list = pref_service_.GetList(kPrefName);
+  ASSERT_EQ(list.size(), 1U);
+  EXPECT_EQ(list[0].GetDict().FindDouble("value"), 10);
+}
+
+TEST_F(TimePeriodStorageCoalescingTest, FlushesOnDestruction) {
+  InitStorage(7);
+  state_->AddDelta(5);
+  EXPECT_TRUE(pref_service_.GetList(kPrefName).empty());
+
+  clock_ = nullptr;
+  state_.reset();
+  const base::Value::List& list = pref_service_.GetList(kPrefName);
+  ASSERT_EQ(list.size(), 1U);
+  EXPECT_EQ(list[0].GetDict().FindDouble("value"), 5);
+
+  TimePeriodStorage reloaded(&pref_service_, kPrefName, 7);
+  EXPECT_EQ(reloaded.GetPeriodSum(), 5U);
+}
+
+TEST_F(TimePeriodStorageCoalescingTest, FlushWritesPendingChanges) {
+  InitStorage(7);
+  state_->AddDelta(3);
+  state_->Flush();
+  const base::Value::List& list = pref_service_.GetList(kPrefName);
+  ASSERT_EQ(list.size(), 1U);
+  EXPECT_EQ(list[0].GetDict().FindDouble("value"), 3);
+}
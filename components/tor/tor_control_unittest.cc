@@ -148,6 +148,9 @@ TEST(TorControlTest, ReadLine) {
   EXPECT_CALL(delegate, OnTorRawAsync("650", "CIRC 1000 EXTENDED")).Times(1);
   EXPECT_CALL(delegate, OnTorRawAsync("650", "EXTRAMAGIC=99")).Times(1);
   EXPECT_CALL(delegate, OnTorRawAsync("650", "ANONYMITY=high")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "STREAM 7 NEW")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "PURPOSE=USER")).Times(1);
+  EXPECT_CALL(delegate, OnTorRawAsync("650", "SOURCE=CACHE")).Times(1);
   EXPECT_CALL(delegate,
               OnTorEvent(TorControlEvent::NETWORK_LIVENESS, "DOWN", testing::_))
       .Times(1);
@@ -156,6 +159,9 @@ TEST(TorControlTest, ReadLine) {
   EXPECT_CALL(delegate,
               OnTorEvent(TorControlEvent::CIRC, "1000 EXTENDED", circ_extra))
       .Times(1);
+  EXPECT_CALL(delegate, OnTorEvent(TorControlEvent::STREAM, testing::_,
+                                   testing::_))
+      .Times(0);
   io_task_runner->PostTask(
       FROM_HERE,
       base::BindOnce(
@@ -180,6 +186,15 @@ TEST(TorControlTest, ReadLine) {
             EXPECT_TRUE(control->ReadLine("650-EXTRAMAGIC=99"));
             EXPECT_TRUE(control->ReadLine("650 ANONYMITY=high"));
             EXPECT_FALSE(control->async_);
+            // Known but unsubscribed multi async is skipped unparsed
+            EXPECT_TRUE(control->ReadLine("650-STREAM 7 NEW"));
+            EXPECT_TRUE(control->async_);
+            EXPECT_TRUE(control->async_->skip);
+            EXPECT_TRUE(control->async_->initial.empty());
+            EXPECT_TRUE(control->ReadLine("650-PURPOSE=USER"));
+            EXPECT_TRUE(control->async_->extra.empty());
+            EXPECT_TRUE(control->ReadLine("650 SOURCE=CACHE"));
+            EXPECT_FALSE(control->async_);
           },
           std::move(control)));
 
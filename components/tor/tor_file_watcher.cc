@@ -21,8 +21,10 @@ namespace tor {
 
 namespace {
 
-constexpr base::TaskTraits kWatchTaskTraits = {base::MayBlock(),
-                                               base::TaskPriority::BEST_EFFORT};
+// The Tor window is blocked on the control channel, so the watch sequence
+// must not be deferred like BEST_EFFORT work is during browser startup.
+constexpr base::TaskTraits kWatchTaskTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE};
 
 #if BUILDFLAG(IS_WIN)
 constexpr char kControlPortMinTmpl[] = "PORT=1.1.1.1:1\r\n";
@@ -12,6 +12,7 @@
 #include "base/callback_helpers.h"
 #include "base/task/bind_post_task.h"
 #include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
 #include "brave/components/tor/tor_file_watcher.h"
 #include "brave/components/tor/tor_launcher_observer.h"
 #include "brave/components/tor/tor_utils.h"
@@ -28,6 +29,14 @@ constexpr char kStatusClientBootstrapProgress[] = "PROGRESS=";
 constexpr char kStatusSummary[] = "SUMMARY=";
 constexpr char kStatusClientCircuitEstablished[] = "CIRCUIT_ESTABLISHED";
 constexpr char kStatusClientCircuitNotEstablished[] = "CIRCUIT_NOT_ESTABLISHED";
+
+constexpr char kTraceCategory[] = "brave";
+constexpr char kTorStartupTrace[] = "TorStartup";
+// Phases of Tor window startup, in the order they happen.
+constexpr char kLaunchPhase[] = "TorLaunchProcess";
+constexpr char kControlFilesPhase[] = "TorWaitForControlFiles";
+constexpr char kControlConnectPhase[] = "TorControlConnect";
+constexpr char kBootstrapPhase[] = "TorBootstrap";
 }  // namespace
 
 // static
@@ -86,6 +95,7 @@ void TorLauncherFactory::LaunchTorProcess(const tor::mojom::TorConfig& config) {
   DCHECK(!config.tor_data_path.empty());
   DCHECK(!config.tor_watch_path.empty());
   config_ = config;
+  BeginStartupTrace();
 
   // Tor launcher could be null if we created Tor process and killed it
   // through KillTorProcess function before. So we need to initialize
@@ -101,12 +111,14 @@ void TorLauncherFactory::LaunchTorInternal() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   if (tor_launcher_.is_bound()) {
+    SetStartupPhase(kLaunchPhase);
     auto config = tor::mojom::TorConfig::New(config_);
     tor_launcher_->Launch(std::move(config),
                           base::BindOnce(&TorLauncherFactory::OnTorLaunched,
                                          weak_ptr_factory_.GetWeakPtr()));
   } else {
     is_starting_ = false;
+    EndStartupTrace();
   }
 }
 
@@ -120,6 +132,7 @@ void TorLauncherFactory::KillTorProcess() {
   is_starting_ = false;
   is_connected_ = false;
   tor_log_.clear();
+  EndStartupTrace();
 }
 
 int64_t TorLauncherFactory::GetTorPid() const {
@@ -213,20 +226,19 @@ void TorLauncherFactory::OnTorLaunched(bool result, int64_t pid) {
     tor_pid_ = pid;
   } else {
     LOG(ERROR) << "Tor Launching Failed(" << pid << ")";
+    EndStartupTrace();
     return;
   }
 
-  tor::TorFileWatcher* tor_file_watcher =
-      new tor::TorFileWatcher(config_.tor_watch_path);
-  tor_file_watcher->StartWatching(base::BindPostTask(
-      base::SequencedTaskRunnerHandle::Get(),
-      base::BindOnce(&TorLauncherFactory::OnTorControlPrerequisitesReady,
-                     weak_ptr_factory_.GetWeakPtr(), pid)));
+  SetStartupPhase(kControlFilesPhase);
+  WatchTorControlFiles(pid);
 }
 
 void TorLauncherFactory::OnTorControlReady() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   VLOG(2) << "TOR CONTROL: Ready!";
+  if (startup_phase_)
+    SetStartupPhase(kBootstrapPhase);
   control_->GetVersion(
       base::BindPostTask(base::SequencedTaskRunnerHandle::Get(),
                          base::BindOnce(&TorLauncherFactory::GotVersion,
@@ -298,6 +310,8 @@ void TorLauncherFactory::GotCircuitEstablished(bool error, bool established) {
     return;
   }
   is_connected_ = established;
+  if (established)
+    EndStartupTrace();
   for (auto& observer : observers_)
     observer.OnTorCircuitEstablished(established);
 }
@@ -308,15 +322,20 @@ void TorLauncherFactory::OnTorControlClosed(bool was_running) {
   // We only try to reestablish tor control connection when tor control was
   // closed unexpectedly and Tor process is still running
   if (was_running && tor_launcher_.is_bound()) {
-    tor::TorFileWatcher* tor_file_watcher =
-        new tor::TorFileWatcher(config_.tor_watch_path);
-    tor_file_watcher->StartWatching(base::BindPostTask(
-        base::SequencedTaskRunnerHandle::Get(),
-        base::BindOnce(&TorLauncherFactory::OnTorControlPrerequisitesReady,
-                       weak_ptr_factory_.GetWeakPtr(), tor_pid_)));
+    WatchTorControlFiles(tor_pid_);
   }
 }
 
+void TorLauncherFactory::WatchTorControlFiles(int64_t pid) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  tor::TorFileWatcher* tor_file_watcher =
+      new tor::TorFileWatcher(config_.tor_watch_path);
+  tor_file_watcher->StartWatching(base::BindPostTask(
+      base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&TorLauncherFactory::OnTorControlPrerequisitesReady,
+                     weak_ptr_factory_.GetWeakPtr(), pid)));
+}
+
 void TorLauncherFactory::OnTorControlPrerequisitesReady(
     int64_t pid,
     bool ready,
@@ -328,15 +347,45 @@ void TorLauncherFactory::OnTorControlPrerequisitesReady(
     return;
   }
   if (ready) {
+    if (startup_phase_)
+      SetStartupPhase(kControlConnectPhase);
     control_->Start(std::move(cookie), port);
   } else {
-    tor::TorFileWatcher* tor_file_watcher =
-        new tor::TorFileWatcher(config_.tor_watch_path);
-    tor_file_watcher->StartWatching(base::BindPostTask(
-        base::SequencedTaskRunnerHandle::Get(),
-        base::BindOnce(&TorLauncherFactory::OnTorControlPrerequisitesReady,
-                       weak_ptr_factory_.GetWeakPtr(), pid)));
+    WatchTorControlFiles(pid);
+  }
+}
+
+void TorLauncherFactory::BeginStartupTrace() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  EndStartupTrace();
+  is_startup_traced_ = true;
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(kTraceCategory, kTorStartupTrace,
+                                    TRACE_ID_LOCAL(this));
+}
+
+void TorLauncherFactory::SetStartupPhase(const char* phase) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!is_startup_traced_)
+    return;
+  if (startup_phase_) {
+    TRACE_EVENT_NESTABLE_ASYNC_END0(kTraceCategory, startup_phase_,
+                                    TRACE_ID_LOCAL(this));
   }
+  startup_phase_ = phase;
+  if (startup_phase_) {
+    TRACE_EVENT_NESTABLE_ASYNC_BEGIN0(kTraceCategory, startup_phase_,
+                                      TRACE_ID_LOCAL(this));
+  }
+}
+
+void TorLauncherFactory::EndStartupTrace() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!is_startup_traced_)
+    return;
+  SetStartupPhase(nullptr);
+  TRACE_EVENT_NESTABLE_ASYNC_END0(kTraceCategory, kTorStartupTrace,
+                                  TRACE_ID_LOCAL(this));
+  is_startup_traced_ = false;
 }
 
 void TorLauncherFactory::RelaunchTor() {
@@ -388,6 +437,7 @@ void TorLauncherFactory::OnTorEvent(
         observer.OnTorInitializing(percentage, message);
     } else if (initial.find(kStatusClientCircuitEstablished) !=
                std::string::npos) {
+      EndStartupTrace();
       for (auto& observer : observers_)
         observer.OnTorCircuitEstablished(true);
       is_connected_ = true;
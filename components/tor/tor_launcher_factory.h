@@ -74,6 +74,9 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   TorLauncherFactory();
   ~TorLauncherFactory() override;
 
+  // Starts a TorFileWatcher for the control port and auth cookie written by
+  // the Tor process |pid|.
+  void WatchTorControlFiles(int64_t pid);
   void OnTorControlPrerequisitesReady(int64_t pid,
                                       bool ready,
                                       std::vector<uint8_t> cookie,
@@ -87,6 +90,12 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
   void GotSOCKSListeners(bool error, const std::vector<std::string>& listeners);
   void GotCircuitEstablished(bool error, bool established);
 
+  // Tor window startup is traced as one async "TorStartup" event with the
+  // current phase nested inside it. Passing nullptr ends the current phase.
+  void BeginStartupTrace();
+  void SetStartupPhase(const char* phase);
+  void EndStartupTrace();
+
   void LaunchTorInternal();
   void RelaunchTor();
   void DelayedRelaunchTor();
@@ -103,6 +112,9 @@ class TorLauncherFactory : public tor::TorControl::Delegate {
 
   int64_t tor_pid_;
 
+  bool is_startup_traced_ = false;
+  const char* startup_phase_ = nullptr;
+
   tor::mojom::TorConfig config_;
 
   base::ObserverList<TorLauncherObserver> observers_;
@@ -0,0 +1,117 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/url_pattern_matcher/url_pattern_matcher.h"
+
+#include <algorithm>
+
+#include "base/strings/string_piece.h"
+#include "extensions/common/url_pattern_set.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+// URLPattern ignores a trailing dot on both the pattern and the URL host.
+base::StringPiece TrimTrailingDot(base::StringPiece host) {
+  if (!host.empty() && host.back() == '.')
+    host.remove_suffix(1);
+  return host;
+}
+
+}  // namespace
+
+URLPatternMatcher::URLPatternMatcher() = default;
+URLPatternMatcher::URLPatternMatcher(URLPatternMatcher&&) = default;
+URLPatternMatcher& URLPatternMatcher::operator=(URLPatternMatcher&&) = default;
+URLPatternMatcher::~URLPatternMatcher() = default;
+
+void URLPatternMatcher::AddPattern(const URLPattern& pattern,
+                                   RuleId rule_id) {
+  const size_t index = entries_.size();
+  entries_.push_back({pattern, rule_id});
+
+  const base::StringPiece host = TrimTrailingDot(pattern.host());
+  if (pattern.match_all_urls() || host.empty()) {
+    any_host_entries_.push_back(index);
+  } else if (pattern.match_subdomains()) {
+    subdomain_entries_[std::string(host)].push_back(index);
+  } else {
+    exact_host_entries_[std::string(host)].push_back(index);
+  }
+}
+
+void URLPatternMatcher::AddPatterns(const extensions::URLPatternSet& patterns,
+                                    RuleId rule_id) {
+  for (const URLPattern& pattern : patterns)
+    AddPattern(pattern, rule_id);
+}
+
+template <typename Visitor>
+void URLPatternMatcher::ForEachCandidate(const GURL& url,
+                                         Visitor visitor) const {
+  const auto visit_bucket = [&visitor](const std::vector<size_t>& bucket) {
+    for (size_t index : bucket) {
+      if (visitor(index))
+        return true;
+    }
+    return false;
+  };
+
+  if (visit_bucket(any_host_entries_))
+    return;
+
+  // Like URLPattern, match filesystem: URLs by their inner URL.
+  const GURL* host_url = url.SchemeIsFileSystem() ? url.inner_url() : &url;
+  if (!host_url)
+    return;
+  base::StringPiece host = TrimTrailingDot(host_url->host_piece());
+  if (host.empty())
+    return;
+
+  const auto exact = exact_host_entries_.find(host);
+  if (exact != exact_host_entries_.end() && visit_bucket(exact->second))
+    return;
+
+  // Subdomain patterns can be for the host itself or any parent domain.
+  while (true) {
+    const auto subdomain = subdomain_entries_.find(host);
+    if (subdomain != subdomain_entries_.end() &&
+        visit_bucket(subdomain->second)) {
+      return;
+    }
+    const size_t dot = host.find('.');
+    if (dot == base::StringPiece::npos)
+      return;
+    host.remove_prefix(dot + 1);
+  }
+}
+
+std::vector<URLPatternMatcher::RuleId> URLPatternMatcher::GetMatchingRules(
+    const GURL& url) const {
+  std::vector<RuleId> rule_ids;
+  ForEachCandidate(url, [this, &url, &rule_ids](size_t index) {
+    const Entry& entry = entries_[index];
+    if (entry.pattern.MatchesURL(url))
+      rule_ids.push_back(entry.rule_id);
+    return false;
+  });
+  std::sort(rule_ids.begin(), rule_ids.end());
+  rule_ids.erase(std::unique(rule_ids.begin(), rule_ids.end()),
+                 rule_ids.end());
+  return rule_ids;
+}
+
+bool URLPatternMatcher::Matches(const GURL& url) const {
+  bool matches = false;
+  ForEachCandidate(url, [this, &url, &matches](size_t index) {
+    matches = entries_[index].pattern.MatchesURL(url);
+    return matches;
+  });
+  return matches;
+}
+
+}  // namespace brave
@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_URL_PATTERN_MATCHER_URL_PATTERN_MATCHER_H_
+#define BRAVE_COMPONENTS_URL_PATTERN_MATCHER_URL_PATTERN_MATCHER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace extensions {
+class URLPatternSet;
+}  // namespace extensions
+
+namespace brave {
+
+// Matches a URL against many URLPatterns at once, e.g. all the include
+// patterns of a rules list.
+//
+// Each pattern is tagged with a caller-chosen rule id, typically the index of
+// the rule it came from. Patterns are bucketed by host when added: patterns
+// for one exact host, for a host and its subdomains, and for any host. A
+// lookup only visits the buckets of the URL's host and of its parent domains
+// and runs the full URLPattern check on those candidates alone, so its cost
+// doesn't grow with patterns for unrelated hosts.
+class URLPatternMatcher {
+ public:
+  using RuleId = size_t;
+
+  URLPatternMatcher();
+  URLPatternMatcher(URLPatternMatcher&&);
+  URLPatternMatcher& operator=(URLPatternMatcher&&);
+  ~URLPatternMatcher();
+
+  URLPatternMatcher(const URLPatternMatcher&) = delete;
+  URLPatternMatcher& operator=(const URLPatternMatcher&) = delete;
+
+  void AddPattern(const URLPattern& pattern, RuleId rule_id);
+  void AddPatterns(const extensions::URLPatternSet& patterns, RuleId rule_id);
+
+  // Returns the ids of all rules with at least one pattern matching |url|,
+  // in increasing order.
+  std::vector<RuleId> GetMatchingRules(const GURL& url) const;
+
+  // Returns true if any pattern matches |url|.
+  bool Matches(const GURL& url) const;
+
+  bool empty() const { return entries_.empty(); }
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    URLPattern pattern;
+    RuleId rule_id;
+  };
+  using HostBuckets = std::map<std::string, std::vector<size_t>, std::less<>>;
+
+  // Runs |visitor| with the index in |entries_| of every pattern that may
+  // match |url|, stopping early once it returns true.
+  template <typename Visitor>
+  void ForEachCandidate(const GURL& url, Visitor visitor) const;
+
+  std::vector<Entry> entries_;
+  // Indices into |entries_|, keyed by pattern host without a trailing dot.
+  HostBuckets exact_host_entries_;
+  HostBuckets subdomain_entries_;
+  std::vector<size_t> any_host_entries_;
+};
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_URL_PATTERN_MATCHER_URL_PATTERN_MATCHER_H_
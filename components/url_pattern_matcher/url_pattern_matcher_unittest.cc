@@ -0,0 +1,160 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/url_pattern_matcher/url_pattern_matcher.h"
+
+#include <string>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+#include "base/timer/elapsed_timer.h"
+#include "extensions/common/url_pattern.h"
+#include "extensions/common/url_pattern_set.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace brave {
+
+namespace {
+
+constexpr int kValidSchemes =
+    URLPattern::SCHEME_HTTP | URLPattern::SCHEME_HTTPS;
+
+URLPattern MakePattern(const std::string& pattern) {
+  URLPattern result(kValidSchemes);
+  EXPECT_EQ(URLPattern::ParseResult::kSuccess, result.Parse(pattern))
+      << pattern;
+  return result;
+}
+
+using RuleIds = std::vector<URLPatternMatcher::RuleId>;
+
+}  // namespace
+
+TEST(URLPatternMatcherTest, Empty) {
+  URLPatternMatcher matcher;
+  EXPECT_TRUE(matcher.empty());
+  EXPECT_TRUE(matcher.GetMatchingRules(GURL("https://brave.com/")).empty());
+  EXPECT_FALSE(matcher.Matches(GURL("https://brave.com/")));
+}
+
+TEST(URLPatternMatcherTest, MatchesHosts) {
+  URLPatternMatcher matcher;
+  matcher.AddPattern(MakePattern("https://brave.com/*"), 0);
+  matcher.AddPattern(MakePattern("*://*.example.com/*"), 1);
+  matcher.AddPattern(MakePattern("*://*/*?redirect=*"), 2);
+  matcher.AddPattern(MakePattern("http://a.example.com/path"), 3);
+  EXPECT_EQ(4u, matcher.size());
+
+  EXPECT_EQ(RuleIds({0}), matcher.GetMatchingRules(GURL("https://brave.com/")));
+  // Exact host patterns don't cover subdomains or other schemes.
+  EXPECT_EQ(RuleIds(),
+            matcher.GetMatchingRules(GURL("https://search.brave.com/")));
+  EXPECT_EQ(RuleIds(), matcher.GetMatchingRules(GURL("http://brave.com/")));
+  // Subdomain patterns cover the domain itself and any subdomain.
+  EXPECT_EQ(RuleIds({1}),
+            matcher.GetMatchingRules(GURL("https://example.com/")));
+  EXPECT_EQ(RuleIds({1, 3}),
+            matcher.GetMatchingRules(GURL("http://a.example.com/path")));
+  EXPECT_EQ(RuleIds({1}),
+            matcher.GetMatchingRules(GURL("http://b.a.example.com/path")));
+  EXPECT_EQ(RuleIds(),
+            matcher.GetMatchingRules(GURL("https://notexample.com/")));
+  // Patterns for any host are tried on every URL.
+  EXPECT_EQ(RuleIds({0, 2}),
+            matcher.GetMatchingRules(GURL("https://brave.com/?redirect=x")));
+  EXPECT_EQ(RuleIds({2}),
+            matcher.GetMatchingRules(GURL("https://test.com/?redirect=x")));
+  // A trailing dot on the host is ignored.
+  EXPECT_EQ(RuleIds({0}),
+            matcher.GetMatchingRules(GURL("https://brave.com./")));
+}
+
+TEST(URLPatternMatcherTest, ReturnsEachRuleOnce) {
+  extensions::URLPatternSet patterns;
+  patterns.AddPattern(MakePattern("*://*.brave.com/*"));
+  patterns.AddPattern(MakePattern("https://search.brave.com/*"));
+  patterns.AddPattern(MakePattern("<all_urls>"));
+
+  URLPatternMatcher matcher;
+  matcher.AddPattern(MakePattern("https://search.brave.com/*"), 7);
+  matcher.AddPatterns(patterns, 3);
+
+  EXPECT_EQ(RuleIds({3, 7}),
+            matcher.GetMatchingRules(GURL("https://search.brave.com/")));
+  EXPECT_EQ(RuleIds({3}), matcher.GetMatchingRules(GURL("https://a.com/")));
+  EXPECT_TRUE(matcher.Matches(GURL("https://a.com/")));
+  EXPECT_FALSE(matcher.Matches(GURL("ftp://a.com/")));
+}
+
+TEST(URLPatternMatcherTest, AgreesWithURLPatternSet) {
+  const char* const kPatterns[] = {
+      "https://*/*",          "*://*.com/*",         "*://brave.com/a/*",
+      "*://*.brave.com/b*",   "http://127.0.0.1/*",  "*://*.co.uk/*?q=*",
+      "*://www.bbc.co.uk/*",  "https://*.a.b.c.d/*",
+  };
+  const char* const kURLs[] = {
+      "https://brave.com/",         "http://brave.com/a/b",
+      "http://x.brave.com/bc",      "http://127.0.0.1/",
+      "http://www.bbc.co.uk/news",  "http://shop.co.uk/?q=1",
+      "https://c.d/",               "https://z.a.b.c.d/",
+      "http://test.org/",           "http://[::1]/",
+  };
+
+  for (const char* pattern : kPatterns) {
+    URLPatternMatcher matcher;
+    matcher.AddPattern(MakePattern(pattern), 0);
+    for (const char* url : kURLs) {
+      EXPECT_EQ(MakePattern(pattern).MatchesURL(GURL(url)),
+                matcher.Matches(GURL(url)))
+          << pattern << " " << url;
+    }
+  }
+}
+
+// Matches 100k URLs against 10k host patterns. Disabled by default since it
+// only reports timings; run with --gtest_also_run_disabled_tests.
+TEST(URLPatternMatcherTest, DISABLED_ManyPatterns) {
+  constexpr int kPatternCount = 10000;
+  constexpr int kURLCount = 100000;
+
+  URLPatternMatcher matcher;
+  extensions::URLPatternSet pattern_set;
+  for (int i = 0; i < kPatternCount; ++i) {
+    const std::string pattern =
+        i % 2 ? base::StringPrintf("*://*.site%d.com/*", i)
+              : base::StringPrintf("https://www.site%d.com/path/*", i);
+    matcher.AddPattern(MakePattern(pattern), i);
+    pattern_set.AddPattern(MakePattern(pattern));
+  }
+  std::vector<GURL> urls;
+  urls.reserve(kURLCount);
+  for (int i = 0; i < kURLCount; ++i) {
+    urls.emplace_back(base::StringPrintf("https://www.site%d.com/path/%d",
+                                         i % (kPatternCount * 2), i));
+  }
+
+  base::ElapsedTimer matcher_timer;
+  size_t matcher_matches = 0;
+  for (const GURL& url : urls)
+    matcher_matches += matcher.GetMatchingRules(url).size();
+  const base::TimeDelta matcher_time = matcher_timer.Elapsed();
+
+  // The linear scan is sampled, it would otherwise take minutes.
+  constexpr int kLinearSample = 100;
+  base::ElapsedTimer linear_timer;
+  for (int i = 0; i < kURLCount; i += kURLCount / kLinearSample)
+    pattern_set.MatchesURL(urls[i]);
+  const base::TimeDelta linear_time =
+      linear_timer.Elapsed() * (kURLCount / kLinearSample);
+
+  EXPECT_EQ(static_cast<size_t>(kURLCount / 2), matcher_matches);
+  LOG(INFO) << "URLPatternMatcher: " << matcher_time.InMilliseconds()
+            << " ms, URLPatternSet (extrapolated): "
+            << linear_time.InMilliseconds() << " ms";
+}
+
+}  // namespace brave
@@ -0,0 +1,28 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "brave/components/url_sanitizer/browser/strip_query_parameters.h"
+
+namespace brave {
+
+namespace internal {
+
+base::StringPiece GetStrippableQueryKey(base::StringPiece key_value) {
+  // Matches splitting the pair on '=' and dropping empty pieces: the key is
+  // the first non-empty piece and there has to be at least one more.
+  const size_t key_begin = key_value.find_first_not_of('=');
+  if (key_begin == base::StringPiece::npos)
+    return base::StringPiece();
+  const size_t key_end = key_value.find('=', key_begin);
+  if (key_end == base::StringPiece::npos ||
+      key_value.find_first_not_of('=', key_end) == base::StringPiece::npos) {
+    return base::StringPiece();
+  }
+  return key_value.substr(key_begin, key_end - key_begin);
+}
+
+}  // namespace internal
+
+}  // namespace brave
@@ -0,0 +1,70 @@
+/* Copyright (c) 2022 The Brave Authors. All rights reserved.
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this file,
+ * You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef BRAVE_COMPONENTS_URL_SANITIZER_BROWSER_STRIP_QUERY_PARAMETERS_H_
+#define BRAVE_COMPONENTS_URL_SANITIZER_BROWSER_STRIP_QUERY_PARAMETERS_H_
+
+#include <string>
+
+#include "base/strings/string_piece.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace brave {
+
+namespace internal {
+
+// Returns the key of a single |key_value| query pair, or an empty piece if
+// the pair is not a candidate for removal. Only pairs with a non-empty key
+// and a non-empty value are, e.g. "a=b" but not "a", "a=" or "=b".
+base::StringPiece GetStrippableQueryKey(base::StringPiece key_value);
+
+}  // namespace internal
+
+// Removes the parameters whose key |should_strip| returns true for from
+// |query|, leaving all other parts of the query untouched, including empty
+// and malformed pairs. Returns absl::nullopt without allocating if nothing
+// was removed.
+//
+// We are using custom query string parsing code here. See
+// https://github.com/brave/brave-core/pull/13726#discussion_r897712350
+// for more information on why this approach was selected.
+template <typename ShouldStrip>
+absl::optional<std::string> StripQueryParameters(base::StringPiece query,
+                                                 ShouldStrip should_strip) {
+  absl::optional<std::string> result;
+  size_t kept_count = 0;
+  size_t begin = 0;
+  while (true) {
+    size_t end = query.find('&', begin);
+    if (end == base::StringPiece::npos)
+      end = query.size();
+    const base::StringPiece key_value = query.substr(begin, end - begin);
+    const base::StringPiece key = internal::GetStrippableQueryKey(key_value);
+    if (!key.empty() && should_strip(key)) {
+      if (!result) {
+        // Everything before the first removed pair is kept as is.
+        result.emplace();
+        result->reserve(query.size());
+        if (begin > 0)
+          result->append(query.data(), begin - 1);
+      }
+    } else {
+      if (result) {
+        if (kept_count > 0)
+          result->push_back('&');
+        result->append(key_value.data(), key_value.size());
+      }
+      ++kept_count;
+    }
+    if (end == query.size())
+      break;
+    begin = end + 1;
+  }
+  return result;
+}
+
+}  // namespace brave
+
+#endif  // BRAVE_COMPONENTS_URL_SANITIZER_BROWSER_STRIP_QUERY_PARAMETERS_H_
@@ -5,16 +5,16 @@
 
 #include "brave/components/url_sanitizer/browser/url_sanitizer_service.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 #include "base/json/json_reader.h"
 #include "base/logging.h"
-#include "base/strings/string_split.h"
-#include "base/strings/string_util.h"
 #include "base/task/task_runner_util.h"
 #include "base/task/thread_pool.h"
 #include "base/values.h"
+#include "brave/components/url_sanitizer/browser/strip_query_parameters.h"
 #include "extensions/common/url_pattern.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "url/gurl.h"
@@ -48,7 +48,7 @@ absl::optional<base::flat_set<std::string>> CreateParamsList(
   return result;
 }
 
-base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
+std::vector<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
     const std::string& json) {
   auto parsed_json = base::JSONReader::ReadAndReturnValueWithError(json);
   if (!parsed_json.has_value()) {
@@ -59,7 +59,7 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
   if (!list) {
     return {};
   }
-  base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> matchers;
+  std::vector<std::unique_ptr<URLSanitizerService::MatchItem>> matchers;
   for (const auto& it : *list) {
     const base::Value::Dict* items = it.GetIfDict();
     if (!items)
@@ -83,7 +83,7 @@ base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> ParseFromJson(
         std::move(include_matcher), std::move(exclude_matcher),
         std::move(*params));
 
-    matchers.insert(std::move(item));
+    matchers.push_back(std::move(item));
   }
 
   return matchers;
@@ -111,8 +111,13 @@ void URLSanitizerService::Initialize(const std::string& json) {
 }
 
 void URLSanitizerService::UpdateMatchers(
-    base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> mappings) {
+    std::vector<std::unique_ptr<URLSanitizerService::MatchItem>> mappings) {
   matchers_ = std::move(mappings);
+
+  include_matcher_ = URLPatternMatcher();
+  for (size_t index = 0; index < matchers_.size(); ++index)
+    include_matcher_.AddPatterns(matchers_[index]->include, index);
+
   if (initialization_callback_for_testing_)
     std::move(initialization_callback_for_testing_).Run();
 }
@@ -120,18 +125,35 @@ void URLSanitizerService::UpdateMatchers(
 GURL URLSanitizerService::SanitizeURL(const GURL& initial_url) {
   if (matchers_.empty() || !initial_url.SchemeIsHTTPOrHTTPS())
     return initial_url;
+  if (!initial_url.has_query())
+    return initial_url;
   GURL url = initial_url;
-  for (const auto& it : matchers_) {
-    if (!it->include.MatchesURL(url) || it->exclude.MatchesURL(url))
+  std::vector<size_t> candidates = include_matcher_.GetMatchingRules(url);
+  auto candidate = candidates.begin();
+  while (candidate != candidates.end()) {
+    const size_t index = *candidate++;
+    const auto& it = matchers_[index];
+    if (it->exclude.MatchesURL(url))
+      continue;
+    auto sanitized_query = StripQueryParameters(
+        url.query_piece(), [&it](base::StringPiece key) {
+          return it->params.contains(key);
+        });
+    if (!sanitized_query)
       continue;
-    auto sanitized_query = StripQueryParameter(url.query(), it->params);
     GURL::Replacements replacements;
-    if (!sanitized_query.empty()) {
-      replacements.SetQueryStr(sanitized_query);
+    if (!sanitized_query->empty()) {
+      replacements.SetQueryStr(*sanitized_query);
     } else {
       replacements.ClearQuery();
     }
     url = url.ReplaceComponents(replacements);
+    if (!url.has_query())
+      break;
+    // Include patterns can cover the query, so the remaining matchers are
+    // looked up again for the sanitized URL.
+    candidates = include_matcher_.GetMatchingRules(url);
+    candidate = std::upper_bound(candidates.begin(), candidates.end(), index);
   }
   return url;
 }
@@ -140,39 +162,14 @@ void URLSanitizerService::OnRulesReady(const std::string& json_content) {
   Initialize(json_content);
 }
 
-// FIXME: merge with
-// browser/net/brave_site_hacks_network_delegate_helper.cc::StripQueryParameter()
-// Remove tracking query parameters from a GURL, leaving all
-// other parts untouched.
 std::string URLSanitizerService::StripQueryParameter(
     const std::string& query,
     const base::flat_set<std::string>& trackers) {
-  // We are using custom query string parsing code here. See
-  // https://github.com/brave/brave-core/pull/13726#discussion_r897712350
-  // for more information on why this approach was selected.
-  //
-  // Split query string by ampersands, remove tracking parameters,
-  // then join the remaining query parameters, untouched, back into
-  // a single query string.
-  const std::vector<std::string> input_kv_strings =
-      SplitString(query, "&", base::KEEP_WHITESPACE, base::SPLIT_WANT_ALL);
-  std::vector<std::string> output_kv_strings;
-  int disallowed_count = 0;
-  for (const std::string& kv_string : input_kv_strings) {
-    const std::vector<std::string> pieces = SplitString(
-        kv_string, "=", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-    const std::string& key = pieces.empty() ? std::string() : pieces[0];
-    if (pieces.size() >= 2 && trackers.count(key) == 1) {
-      ++disallowed_count;
-    } else {
-      output_kv_strings.push_back(kv_string);
-    }
-  }
-  if (disallowed_count > 0) {
-    return base::JoinString(output_kv_strings, "&");
-  } else {
-    return query;
-  }
+  auto sanitized_query =
+      StripQueryParameters(query, [&trackers](base::StringPiece key) {
+        return trackers.contains(key);
+      });
+  return sanitized_query.value_or(query);
 }
 
 }  // namespace brave
@@ -9,13 +9,14 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/callback.h"
-#include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/weak_ptr.h"
 #include "base/strings/string_piece.h"
+#include "brave/components/url_pattern_matcher/url_pattern_matcher.h"
 #include "brave/components/url_sanitizer/browser/url_sanitizer_component_installer.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "extensions/common/url_pattern_set.h"
@@ -53,13 +54,15 @@ class URLSanitizerService : public KeyedService,
   friend class URLSanitizerServiceUnitTest;
 
   void UpdateMatchers(
-      base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>>);
+      std::vector<std::unique_ptr<URLSanitizerService::MatchItem>>);
 
   std::string StripQueryParameter(const std::string& query,
                                   const base::flat_set<std::string>& trackers);
 
  private:
-  base::flat_set<std::unique_ptr<URLSanitizerService::MatchItem>> matchers_;
+  std::vector<std::unique_ptr<URLSanitizerService::MatchItem>> matchers_;
+  // Include patterns of all |matchers_|, tagged with the matcher index.
+  URLPatternMatcher include_matcher_;
   base::OnceClosure initialization_callback_for_testing_;
   base::WeakPtrFactory<URLSanitizerService> weak_factory_{this};
 };
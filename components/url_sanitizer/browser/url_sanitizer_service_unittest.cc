@@ -86,6 +86,36 @@ TEST_F(URLSanitizerServiceUnitTest, StripQueryParameter) {
       "param1=1");
   EXPECT_EQ(StripQueryParameter("param1=1", list), "param1=1");
   EXPECT_EQ(StripQueryParameter("", list), "");
+  // Pairs without both a key and a value are never removed.
+  EXPECT_EQ(StripQueryParameter("fbclid&fbclid=&=fbclid", list),
+            "fbclid&fbclid=&=fbclid");
+  EXPECT_EQ(StripQueryParameter("a&&fbclid=1&", list), "a&&");
+  EXPECT_EQ(StripQueryParameter("==fbclid=1&a", list), "a");
+}
+
+TEST_F(URLSanitizerServiceUnitTest, MatchersAreIndexedByDomain) {
+  WaitInitialization(R"([
+    { "include": [ "*://*.example.com/*", "*://brave.com/*" ],
+      "params": ["first"] },
+    { "include": [ "*://*/*" ],
+      "exclude": [ "*://exempted.example.com/*" ],
+      "params": ["second"] },
+    { "include": [ "*://127.0.0.1/*" ], "params": ["third"] }
+  ])");
+
+  EXPECT_EQ(SanitizeURL(GURL("https://sub.example.com/?first=1&second=2&a")),
+            GURL("https://sub.example.com/?a"));
+  EXPECT_EQ(SanitizeURL(GURL("https://brave.com/?first=1&second=2&a")),
+            GURL("https://brave.com/?a"));
+  EXPECT_EQ(
+      SanitizeURL(GURL("https://exempted.example.com/?first=1&second=2&a")),
+      GURL("https://exempted.example.com/?second=2&a"));
+  EXPECT_EQ(SanitizeURL(GURL("https://other.com/?first=1&second=2&a")),
+            GURL("https://other.com/?first=1&a"));
+  EXPECT_EQ(SanitizeURL(GURL("http://127.0.0.1/?first=1&third=3&second=2")),
+            GURL("http://127.0.0.1/?first=1"));
+  EXPECT_EQ(SanitizeURL(GURL("https://sub.example.com/?first=1&second=2")),
+            GURL("https://sub.example.com/"));
 }
 
 TEST_F(URLSanitizerServiceUnitTest, ClearURLS) {
@@ -10,8 +10,10 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "base/check.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/types.h"
@@ -25,10 +27,14 @@ uint32_t graphml_index = 0;
 GraphMLAttr::GraphMLAttr(const GraphMLAttrForType for_value,
                          const std::string& name,
                          const GraphMLAttrType type)
-    : id_(++graphml_index), for_(for_value), name_(name), type_(type) {}
+    : id_(++graphml_index),
+      graphml_id_("d" + base::NumberToString(id_)),
+      for_(for_value),
+      name_(name),
+      type_(type) {}
 
-GraphMLId GraphMLAttr::GetGraphMLId() const {
-  return "d" + base::NumberToString(id_);
+const GraphMLId& GraphMLAttr::GetGraphMLId() const {
+  return graphml_id_;
 }
 
 void GraphMLAttr::AddDefinitionNode(xmlNodePtr parent_node) const {
@@ -119,6 +125,60 @@ void GraphMLAttr::AddValueNode(xmlDocPtr doc,
   xmlSetProp(new_node, BAD_CAST "key", BAD_CAST GetGraphMLId().c_str());
 }
 
+GraphMLStreamWriter::GraphMLStreamWriter(size_t chunk_size,
+                                         ChunkCallback chunk_callback)
+    : chunk_size_(chunk_size),
+      chunk_callback_(std::move(chunk_callback)),
+      doc_(xmlNewDoc(BAD_CAST "1.0")),
+      scratch_node_(xmlNewNode(nullptr, BAD_CAST "graphml")),
+      dump_buffer_(xmlBufferCreate()) {
+  DCHECK(chunk_callback_);
+  xmlDocSetRootElement(doc_, scratch_node_);
+  pending_.reserve(chunk_size_);
+}
+
+GraphMLStreamWriter::~GraphMLStreamWriter() {
+  xmlBufferFree(dump_buffer_);
+  xmlFreeDoc(doc_);
+}
+
+void GraphMLStreamWriter::WriteRaw(base::StringPiece data) {
+  pending_.append(data.data(), data.size());
+  MaybeEmitChunk();
+}
+
+void GraphMLStreamWriter::FlushScratchNode() {
+  xmlNodePtr child = scratch_node_->children;
+  while (child) {
+    xmlNodePtr next = child->next;
+    xmlNodeDump(dump_buffer_, doc_, child, 0, 0);
+    pending_.append(
+        reinterpret_cast<const char*>(xmlBufferContent(dump_buffer_)),
+        xmlBufferLength(dump_buffer_));
+    xmlBufferEmpty(dump_buffer_);
+    xmlUnlinkNode(child);
+    xmlFreeNode(child);
+    child = next;
+  }
+  MaybeEmitChunk();
+}
+
+void GraphMLStreamWriter::Finish() {
+  DCHECK(!scratch_node_->children);
+  if (pending_.empty())
+    return;
+  chunk_callback_.Run(std::move(pending_));
+  pending_ = std::string();
+}
+
+void GraphMLStreamWriter::MaybeEmitChunk() {
+  if (pending_.size() < chunk_size_)
+    return;
+  chunk_callback_.Run(std::move(pending_));
+  pending_ = std::string();
+  pending_.reserve(chunk_size_);
+}
+
 const GraphMLAttrs& GetGraphMLAttrs() {
   static base::NoDestructor<GraphMLAttrs> attrs({
       {kGraphMLAttrDefAttrName,
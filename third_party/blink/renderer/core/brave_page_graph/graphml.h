@@ -10,7 +10,9 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/containers/flat_map.h"
+#include "base/strings/string_piece.h"
 #include "base/time/time.h"
 #include "brave/third_party/blink/renderer/core/brave_page_graph/types.h"
 
@@ -22,7 +24,7 @@ class GraphMLAttr {
               const std::string& name,
               const GraphMLAttrType type = kGraphMLAttrTypeString);
 
-  GraphMLId GetGraphMLId() const;
+  const GraphMLId& GetGraphMLId() const;
   void AddDefinitionNode(xmlNodePtr parent_node) const;
   void AddValueNode(xmlDocPtr doc,
                     xmlNodePtr parent_node,
@@ -51,11 +53,47 @@ class GraphMLAttr {
 
  protected:
   const uint64_t id_;
+  const GraphMLId graphml_id_;
   const GraphMLAttrForType for_;
   const std::string name_;
   const GraphMLAttrType type_;
 };
 
+// Writes a GraphML document incrementally. Callers build one top level element
+// at a time under |scratch_node()| and call |FlushScratchNode()|, which dumps
+// the subtree into the output buffer and frees it, so only a single graph item
+// is ever held as a libxml2 DOM. Buffered output is handed to |chunk_callback|
+// whenever it grows past |chunk_size| bytes; chunks always end on an element
+// boundary and are therefore valid UTF-8 on their own.
+class GraphMLStreamWriter {
+ public:
+  using ChunkCallback = base::RepeatingCallback<void(std::string chunk)>;
+
+  GraphMLStreamWriter(size_t chunk_size, ChunkCallback chunk_callback);
+  ~GraphMLStreamWriter();
+
+  GraphMLStreamWriter(const GraphMLStreamWriter&) = delete;
+  GraphMLStreamWriter& operator=(const GraphMLStreamWriter&) = delete;
+
+  xmlDocPtr doc() const { return doc_; }
+  xmlNodePtr scratch_node() const { return scratch_node_; }
+
+  void WriteRaw(base::StringPiece data);
+  void FlushScratchNode();
+  // Hands any remaining buffered output to the chunk callback.
+  void Finish();
+
+ private:
+  void MaybeEmitChunk();
+
+  const size_t chunk_size_;
+  ChunkCallback chunk_callback_;
+  xmlDocPtr doc_;
+  xmlNodePtr scratch_node_;
+  xmlBufferPtr dump_buffer_;
+  std::string pending_;
+};
+
 using GraphMLAttrs = base::flat_map<GraphMLAttrDef, const GraphMLAttr*>;
 const GraphMLAttrs& GetGraphMLAttrs();
 const GraphMLAttr* GraphMLAttrDefForType(const GraphMLAttrDef type);
@@ -122,7 +122,9 @@
 #include "third_party/blink/renderer/platform/loader/fetch/resource_request.h"
 #include "third_party/blink/renderer/platform/weborigin/kurl.h"
 #include "third_party/blink/renderer/platform/wtf/casting.h"
+#include "third_party/blink/renderer/platform/wtf/functional.h"
 #include "third_party/blink/renderer/platform/wtf/text/base64.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 #include "third_party/blink/renderer/platform/wtf/text/wtf_string.h"
 #include "url/gurl.h"
 #include "v8/include/v8.h"
@@ -187,6 +189,26 @@ constexpr char kPageGraphVersion[] = "0.3.0";
 constexpr char kPageGraphUrl[] =
     "https://github.com/brave/brave-browser/wiki/PageGraph";
 
+// The GraphML envelope is fixed, so it is written as raw text around the
+// streamed <desc>, <key>, <node> and <edge> elements.
+constexpr char kGraphMLPrologue[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\" "
+    "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" "
+    "xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns "
+    "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">";
+constexpr char kGraphMLGraphOpen[] =
+    "<graph id=\"G\" edgedefault=\"directed\">";
+constexpr char kGraphMLEpilogue[] = "</graph></graphml>\n";
+constexpr size_t kGraphMLChunkSize = 1 << 20;
+
+// Initial capacities for the item lists and the hot lookup indexes. Even
+// simple pages produce a few thousand items, so starting here avoids the
+// early rounds of rehashing and vector growth while recording.
+constexpr size_t kInitialGraphItemCapacity = 8192;
+constexpr size_t kInitialHTMLNodeIndexCapacity = 2048;
+constexpr size_t kInitialResourceIndexCapacity = 256;
+
 PageGraph* GetPageGraphFromIsolate(v8::Isolate* isolate) {
   blink::LocalDOMWindow* window = blink::CurrentDOMWindow(isolate);
   if (!window) {
@@ -300,6 +322,13 @@ PageGraph::PageGraph(LocalFrame& local_frame)
   DCHECK(local_frame.IsLocalRoot());
   local_frame.GetProbeSink()->AddPageGraph(this);
 
+  graph_items_.reserve(kInitialGraphItemCapacity);
+  nodes_.reserve(kInitialGraphItemCapacity / 2);
+  edges_.reserve(kInitialGraphItemCapacity / 2);
+  element_nodes_.reserve(kInitialHTMLNodeIndexCapacity);
+  text_nodes_.reserve(kInitialHTMLNodeIndexCapacity);
+  resource_nodes_.reserve(kInitialResourceIndexCapacity);
+
   shields_node_ = AddNode<NodeShields>();
   ad_shield_node_ = AddNode<NodeShield>(brave_shields::kAds);
   tracker_shield_node_ = AddNode<NodeShield>(brave_shields::kTrackers);
@@ -956,22 +985,78 @@ void PageGraph::GenerateReportForNode(const blink::DOMNodeId node_id,
 }
 
 String PageGraph::ToGraphML() const {
-  xmlDocPtr graphml_doc = xmlNewDoc(BAD_CAST "1.0");
-  xmlNodePtr graphml_root_node = xmlNewNode(nullptr, BAD_CAST "graphml");
-  xmlDocSetRootElement(graphml_doc, graphml_root_node);
-
-  xmlNewNs(graphml_root_node, BAD_CAST "http://graphml.graphdrawing.org/xmlns",
-           nullptr);
-  xmlNsPtr xsi_ns = xmlNewNs(
-      graphml_root_node, BAD_CAST "http://www.w3.org/2001/XMLSchema-instance",
-      BAD_CAST "xsi");
-  xmlNewNsProp(graphml_root_node, xsi_ns, BAD_CAST "schemaLocation",
-               BAD_CAST
-               "http://graphml.graphdrawing.org/xmlns "
-               "http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd");
+  // Converting page by page keeps the UTF-8 form of at most one page alive
+  // next to the result.
+  StringBuilder graphml;
+  GraphMLPageCursor cursor = CreateGraphMLPageCursor();
+  while (!cursor.IsDone()) {
+    graphml.Append(
+        String::FromUTF8(GenerateGraphMLPage(kGraphMLChunkSize, &cursor)));
+  }
+  String graphml_string = graphml.ToString();
+  DCHECK(!graphml_string.empty());
+  return graphml_string;
+}
+
+PageGraph::GraphMLPageCursor PageGraph::CreateGraphMLPageCursor() const {
+  GraphMLPageCursor cursor;
+  cursor.node_count = nodes_.size();
+  cursor.edge_count = edges_.size();
+  return cursor;
+}
+
+bool PageGraph::IsValidGraphMLPageCursor(
+    const GraphMLPageCursor& cursor) const {
+  return cursor.node_count <= nodes_.size() &&
+         cursor.edge_count <= edges_.size() &&
+         cursor.next_item <= cursor.node_count + cursor.edge_count + 2;
+}
+
+std::string PageGraph::GenerateGraphMLPage(size_t page_size,
+                                           GraphMLPageCursor* cursor) const {
+  DCHECK(cursor);
+  DCHECK(IsValidGraphMLPageCursor(*cursor));
+
+  // The writer hands over its buffer once it passes |page_size|, which is
+  // where the page ends.
+  std::string page;
+  brave_page_graph::GraphMLStreamWriter writer(
+      page_size, WTF::BindRepeating(
+                     [](std::string* page, std::string chunk) {
+                       page->append(chunk);
+                     },
+                     WTF::Unretained(&page)));
+  xmlDocPtr graphml_doc = writer.doc();
+  xmlNodePtr scratch_node = writer.scratch_node();
+
+  const size_t closing_item = cursor->node_count + cursor->edge_count + 1;
+  while (page.empty() && cursor->next_item <= closing_item) {
+    const size_t item = cursor->next_item++;
+    if (item == 0) {
+      WriteGraphMLHeader(&writer);
+    } else if (item <= cursor->node_count) {
+      nodes_[item - 1]->AddGraphMLTag(graphml_doc, scratch_node);
+      writer.FlushScratchNode();
+    } else if (item < closing_item) {
+      edges_[item - 1 - cursor->node_count]->AddGraphMLTag(graphml_doc,
+                                                          scratch_node);
+      writer.FlushScratchNode();
+    } else {
+      writer.WriteRaw(kGraphMLEpilogue);
+    }
+  }
+  writer.Finish();
+  return page;
+}
+
+void PageGraph::WriteGraphMLHeader(
+    brave_page_graph::GraphMLStreamWriter* writer) const {
+  xmlNodePtr scratch_node = writer->scratch_node();
+
+  writer->WriteRaw(kGraphMLPrologue);
 
   xmlNodePtr desc_container_node =
-      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "desc", nullptr);
+      xmlNewChild(scratch_node, nullptr, BAD_CAST "desc", nullptr);
   xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "version",
                   BAD_CAST kPageGraphVersion);
   xmlNewTextChild(desc_container_node, nullptr, BAD_CAST "about",
@@ -993,31 +1078,11 @@ String PageGraph::ToGraphML() const {
       BAD_CAST base::NumberToString(end_time.InMilliseconds()).c_str());
 
   for (const auto& graphml_attr : brave_page_graph::GetGraphMLAttrs()) {
-    graphml_attr.second->AddDefinitionNode(graphml_root_node);
-  }
-
-  xmlNodePtr graph_node =
-      xmlNewChild(graphml_root_node, nullptr, BAD_CAST "graph", nullptr);
-  xmlSetProp(graph_node, BAD_CAST "id", BAD_CAST "G");
-  xmlSetProp(graph_node, BAD_CAST "edgedefault", BAD_CAST "directed");
-
-  for (const auto* node : nodes_) {
-    node->AddGraphMLTag(graphml_doc, graph_node);
-  }
-  for (const auto* edge : edges_) {
-    edge->AddGraphMLTag(graphml_doc, graph_node);
+    graphml_attr.second->AddDefinitionNode(scratch_node);
   }
+  writer->FlushScratchNode();
 
-  xmlChar* xml_string;
-  int size;
-  xmlDocDumpMemoryEnc(graphml_doc, &xml_string, &size, "UTF-8");
-  auto graphml_string = String::FromUTF8(xml_string, size);
-  DCHECK(!graphml_string.empty());
-
-  xmlFree(xml_string);
-  xmlFree(graphml_doc);
-
-  return graphml_string;
+  writer->WriteRaw(kGraphMLGraphOpen);
 }
 
 NodeHTML* PageGraph::GetHTMLNode(const DOMNodeId node_id) const {
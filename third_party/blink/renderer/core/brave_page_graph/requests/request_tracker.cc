@@ -29,7 +29,8 @@ scoped_refptr<const TrackedRequestRecord> RequestTracker::RegisterRequestStart(
     GraphNode* requester,
     NodeResource* resource,
     const std::string& resource_type) {
-  if (tracked_requests_.count(request_id) == 0) {
+  auto record_it = tracked_requests_.find(request_id);
+  if (record_it == tracked_requests_.end()) {
     auto request_record = std::make_unique<TrackedRequest>(
         request_id, requester, resource, resource_type);
     CheckTracedRequestAgainstHistory(request_record.get());
@@ -39,8 +40,7 @@ scoped_refptr<const TrackedRequestRecord> RequestTracker::RegisterRequestStart(
     return tracking_record;
   }
 
-  tracked_requests_.at(request_id)
-      ->request->AddRequest(requester, resource, resource_type);
+  record_it->second->request->AddRequest(requester, resource, resource_type);
   return ReturnTrackingRecord(request_id);
 }
 
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "base/memory/ref_counted.h"
@@ -71,7 +72,8 @@ class RequestTracker {
   TrackedRequestRecord* GetTrackingRecord(const InspectorId request_id);
 
  private:
-  std::map<InspectorId, scoped_refptr<TrackedRequestRecord>> tracked_requests_;
+  std::unordered_map<InspectorId, scoped_refptr<TrackedRequestRecord>>
+      tracked_requests_;
 
   std::map<blink::DOMNodeId, InspectorId> document_request_initiators_;
   std::map<InspectorId, DocumentRequest> document_requests_;
@@ -84,7 +86,7 @@ class RequestTracker {
   // This structure is just included for debugging, to make sure the
   // assumptions built into this request tracking system (e.g. that
   // request ids will not repeat, etc.).
-  std::map<InspectorId, const NodeResource*> completed_requests_;
+  std::unordered_map<InspectorId, const NodeResource*> completed_requests_;
 
   // These methods manage writing to and from the above structure.
   void AddTracedRequestToHistory(const TrackedRequest* request);